@@ -0,0 +1,1094 @@
+#include "dataset.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+#define LIBSVM_MAX_TOKEN_LENGTH 127
+#define LIBSVM_WRITE_BUFFER_SIZE (1 << 20)
+
+/**
+ * @!visibility private
+ */
+typedef enum {
+  LIBSVM_OK = 0,
+  LIBSVM_INVALID_LABEL,
+  LIBSVM_INCONSISTENT_LABELS,
+  LIBSVM_INVALID_FEATURE,
+  LIBSVM_INVALID_INDEX
+} libsvm_status_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  const char* begin;
+  const char* end;
+  long n_lines;
+  long n_rows;
+  long nnz;
+  long row_offset;
+  long nz_offset;
+  long max_index;
+  int int_labels;
+  libsvm_status_t status;
+  long error_line;
+} libsvm_chunk_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  libsvm_chunk_t* chunks;
+  long n_labels;
+  long index_offset;
+  double* labels;
+  double* data;
+  int32_t* indices;
+  int64_t* indptr;
+} libsvm_ctx_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int zero_based;
+  int n_threads;
+  long line_offset;
+} libsvm_opts_t;
+
+/**
+ * @!visibility private
+ */
+typedef VALUE (*mapped_file_func_t)(const char* buf, const size_t size, VALUE filename, void* arg);
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  VALUE filename;
+  int fd;
+  char* buf;
+  size_t size;
+  int mapped;
+  mapped_file_func_t func;
+  void* arg;
+} mapped_file_t;
+
+/**
+ * @!visibility private
+ */
+static VALUE map_file_and_call(VALUE file_) {
+  mapped_file_t* file = (mapped_file_t*)file_;
+  struct stat st;
+  size_t n_read = 0;
+  ssize_t ret;
+
+  if (fstat(file->fd, &st) != 0) rb_sys_fail_str(file->filename);
+  file->size = (size_t)st.st_size;
+  if (file->size == 0) return file->func(NULL, 0, file->filename, file->arg);
+
+#ifdef HAVE_SYS_MMAN_H
+  file->buf = (char*)mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+  if (file->buf != MAP_FAILED) {
+    file->mapped = 1;
+#ifdef MADV_SEQUENTIAL
+    madvise(file->buf, file->size, MADV_SEQUENTIAL);
+#endif
+    return file->func(file->buf, file->size, file->filename, file->arg);
+  }
+  file->buf = NULL;
+#endif
+  /* fall back to reading the whole file if the memory mapping is unavailable. */
+  file->buf = ALLOC_N(char, file->size);
+  while (n_read < file->size) {
+    ret = read(file->fd, file->buf + n_read, file->size - n_read);
+    if (ret < 0 && errno == EINTR) continue;
+    if (ret <= 0) rb_sys_fail_str(file->filename);
+    n_read += (size_t)ret;
+  }
+  return file->func(file->buf, file->size, file->filename, file->arg);
+}
+
+/**
+ * @!visibility private
+ */
+static VALUE release_mapped_file(VALUE file_) {
+  mapped_file_t* file = (mapped_file_t*)file_;
+
+#ifdef HAVE_SYS_MMAN_H
+  if (file->mapped) munmap(file->buf, file->size);
+#endif
+  if (!file->mapped && file->buf != NULL) xfree(file->buf);
+  if (file->fd >= 0) close(file->fd);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ * Map the whole contents of the file into memory, and call the function with them.
+ * The mapping is released even if the function raises an exception.
+ */
+static VALUE with_mapped_file(VALUE filename, mapped_file_func_t func, void* arg) {
+  mapped_file_t file;
+  VALUE ret;
+
+  FilePathValue(filename);
+  file.filename = filename;
+  file.buf = NULL;
+  file.size = 0;
+  file.mapped = 0;
+  file.func = func;
+  file.arg = arg;
+  file.fd = open(StringValueCStr(filename), O_RDONLY);
+  if (file.fd < 0) rb_sys_fail_str(filename);
+
+  ret = rb_ensure(map_file_and_call, (VALUE)&file, release_mapped_file, (VALUE)&file);
+  RB_GC_GUARD(filename);
+  return ret;
+}
+
+/**
+ * @!visibility private
+ */
+static int is_blank(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+/**
+ * @!visibility private
+ * Return the end of the line content, which is the newline, the beginning of the comment, or the end of buffer.
+ * The beginning of the next line is stored in next.
+ */
+static const char* find_line_end(const char* p, const char* end, const char** next) {
+  const char* eol = memchr(p, '\n', end - p);
+  const char* comment;
+
+  if (eol == NULL) {
+    eol = end;
+    *next = end;
+  } else {
+    *next = eol + 1;
+  }
+  comment = memchr(p, '#', eol - p);
+  return comment == NULL ? eol : comment;
+}
+
+/**
+ * @!visibility private
+ */
+static const char* skip_blanks(const char* p, const char* end) {
+  while (p < end && is_blank(*p)) p++;
+  return p;
+}
+
+/**
+ * @!visibility private
+ */
+static const char* find_blank(const char* p, const char* end) {
+  while (p < end && !is_blank(*p)) p++;
+  return p;
+}
+
+/**
+ * @!visibility private
+ * Check whether the token is an integer written in the canonical form, e.g. "12" and "-3", but not "+3", "-0", and "012".
+ */
+static int is_canonical_integer(const char* s, const long len) {
+  long i = (len > 0 && s[0] == '-') ? 1 : 0;
+
+  if (i >= len) return 0;
+  if (s[i] == '0') return len == 1;
+  for (; i < len; i++) {
+    if (s[i] < '0' || s[i] > '9') return 0;
+  }
+  return 1;
+}
+
+/**
+ * @!visibility private
+ * Parse the token as a floating point number. The token is copied into the local buffer
+ * since the file contents are not terminated with the null character.
+ */
+static int parse_number(const char* s, const long len, double* val) {
+  char buf[LIBSVM_MAX_TOKEN_LENGTH + 1];
+  char* endp;
+
+  if (len <= 0 || len > LIBSVM_MAX_TOKEN_LENGTH) return 0;
+  memcpy(buf, s, len);
+  buf[len] = '\0';
+  *val = strtod(buf, &endp);
+  return endp == buf + len;
+}
+
+/**
+ * @!visibility private
+ */
+static int parse_index(const char* s, const long len, int64_t* idx) {
+  long i;
+
+  if (len <= 0 || len > 10) return 0;
+  *idx = 0;
+  for (i = 0; i < len; i++) {
+    if (s[i] < '0' || s[i] > '9') return 0;
+    *idx = *idx * 10 + (s[i] - '0');
+  }
+  return 1;
+}
+
+/**
+ * @!visibility private
+ */
+static long count_labels(const char* p, const char* end) {
+  long n_labels = 1;
+  for (; p < end; p++) {
+    if (*p == ',') n_labels++;
+  }
+  return n_labels;
+}
+
+/**
+ * @!visibility private
+ * Count the number of lines, samples, and non-zero elements in the chunks.
+ */
+static void count_libsvm_chunks(void* arg, const long begin, const long end) {
+  libsvm_ctx_t* ctx = (libsvm_ctx_t*)arg;
+  libsvm_chunk_t* chunk;
+  const char* p;
+  const char* next;
+  const char* eol;
+  const char* tok_end;
+  long c;
+
+  for (c = begin; c < end; c++) {
+    chunk = &ctx->chunks[c];
+    for (p = chunk->begin; p < chunk->end; p = next) {
+      eol = find_line_end(p, chunk->end, &next);
+      chunk->n_lines++;
+      p = skip_blanks(p, eol);
+      if (p == eol) continue;
+      tok_end = find_blank(p, eol);
+      if (count_labels(p, tok_end) != ctx->n_labels) {
+        chunk->status = LIBSVM_INCONSISTENT_LABELS;
+        chunk->error_line = chunk->n_lines - 1;
+        break;
+      }
+      chunk->n_rows++;
+      for (p = skip_blanks(tok_end, eol); p < eol; p = skip_blanks(p, eol)) {
+        p = find_blank(p, eol);
+        chunk->nnz++;
+      }
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ * Parse the labels and features in the chunks, and then store them in the preallocated buffers.
+ */
+static void parse_libsvm_chunks(void* arg, const long begin, const long end) {
+  libsvm_ctx_t* ctx = (libsvm_ctx_t*)arg;
+  const long n_labels = ctx->n_labels;
+  libsvm_chunk_t* chunk;
+  const char* p;
+  const char* next;
+  const char* eol;
+  const char* tok_end;
+  const char* sep;
+  long c, line, row, nz, k;
+  int64_t idx;
+  double val;
+
+  for (c = begin; c < end; c++) {
+    chunk = &ctx->chunks[c];
+    row = chunk->row_offset;
+    nz = chunk->nz_offset;
+    for (line = 0, p = chunk->begin; p < chunk->end; line++, p = next) {
+      eol = find_line_end(p, chunk->end, &next);
+      p = skip_blanks(p, eol);
+      if (p == eol) continue;
+      /* labels separated with commas. */
+      tok_end = find_blank(p, eol);
+      for (k = 0; k < n_labels; k++, p = sep + 1) {
+        sep = memchr(p, ',', tok_end - p);
+        if (sep == NULL) sep = tok_end;
+        if (!parse_number(p, sep - p, &val)) {
+          chunk->status = LIBSVM_INVALID_LABEL;
+          break;
+        }
+        if (!is_canonical_integer(p, sep - p) || val < INT32_MIN || val > INT32_MAX) chunk->int_labels = 0;
+        ctx->labels[row * n_labels + k] = val;
+      }
+      /* features written as index:value. */
+      for (p = skip_blanks(tok_end, eol); chunk->status == LIBSVM_OK && p < eol; p = skip_blanks(tok_end, eol)) {
+        tok_end = find_blank(p, eol);
+        sep = memchr(p, ':', tok_end - p);
+        if (sep == NULL || !parse_number(sep + 1, tok_end - sep - 1, &val)) {
+          chunk->status = LIBSVM_INVALID_FEATURE;
+        } else if (!parse_index(p, sep - p, &idx) || idx - ctx->index_offset < 0 || idx - ctx->index_offset > INT32_MAX) {
+          chunk->status = LIBSVM_INVALID_INDEX;
+        } else {
+          idx -= ctx->index_offset;
+          if (idx > chunk->max_index) chunk->max_index = idx;
+          ctx->indices[nz] = (int32_t)idx;
+          ctx->data[nz] = val;
+          nz++;
+        }
+      }
+      if (chunk->status != LIBSVM_OK) {
+        chunk->error_line = line;
+        break;
+      }
+      ctx->indptr[++row] = nz;
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ * Raise ArgumentError with the line number if any chunk has failed to be processed.
+ */
+static void check_libsvm_chunks(VALUE filename, libsvm_chunk_t* chunks, const long n_chunks, const long line_offset) {
+  long c, line = line_offset;
+
+  for (c = 0; c < n_chunks; c++) {
+    switch (chunks[c].status) {
+    case LIBSVM_INVALID_LABEL:
+      rb_raise(rb_eArgError, "Invalid label at line %ld of %" PRIsVALUE, line + chunks[c].error_line + 1, filename);
+      break;
+    case LIBSVM_INCONSISTENT_LABELS:
+      rb_raise(rb_eArgError, "Inconsistent number of labels at line %ld of %" PRIsVALUE, line + chunks[c].error_line + 1,
+               filename);
+      break;
+    case LIBSVM_INVALID_FEATURE:
+      rb_raise(rb_eArgError, "Invalid feature at line %ld of %" PRIsVALUE, line + chunks[c].error_line + 1, filename);
+      break;
+    case LIBSVM_INVALID_INDEX:
+      rb_raise(rb_eArgError, "Invalid feature index at line %ld of %" PRIsVALUE, line + chunks[c].error_line + 1,
+               filename);
+      break;
+    default:
+      break;
+    }
+    line += chunks[c].n_lines;
+  }
+}
+
+/**
+ * @!visibility private
+ */
+static VALUE parse_libsvm_buffer(const char* buf, const size_t size, VALUE filename, void* opts_) {
+  const libsvm_opts_t* opts = (libsvm_opts_t*)opts_;
+  const char* end = buf + size;
+  const char* p;
+  const char* next;
+  const char* eol;
+  const long n_chunks = opts->n_threads;
+  libsvm_chunk_t* chunks;
+  libsvm_ctx_t ctx;
+  VALUE chunks_buf = 0;
+  VALUE labels, data, indices, indptr;
+  size_t shape[2];
+  long c, n_rows = 0, nnz = 0, max_index = -1;
+  int int_labels = 1;
+
+  chunks = ALLOCV_N(libsvm_chunk_t, chunks_buf, n_chunks);
+  memset(chunks, 0, n_chunks * sizeof(libsvm_chunk_t));
+  /* split the contents into line-aligned chunks. */
+  for (c = 0; c < n_chunks; c++) {
+    chunks[c].begin = c == 0 ? buf : chunks[c - 1].end;
+    if (c == n_chunks - 1) {
+      chunks[c].end = end;
+    } else {
+      p = buf + (size_t)((double)size * (c + 1) / n_chunks);
+      if (p < chunks[c].begin) p = chunks[c].begin;
+      eol = memchr(p, '\n', end - p);
+      chunks[c].end = eol == NULL ? end : eol + 1;
+    }
+    chunks[c].max_index = -1;
+    chunks[c].int_labels = 1;
+  }
+  /* the number of labels is determined from the first sample. */
+  ctx.chunks = chunks;
+  ctx.n_labels = 1;
+  ctx.index_offset = opts->zero_based ? 0 : 1;
+  for (p = buf; p < end; p = next) {
+    eol = find_line_end(p, end, &next);
+    p = skip_blanks(p, eol);
+    if (p < eol) {
+      ctx.n_labels = count_labels(p, find_blank(p, eol));
+      break;
+    }
+  }
+
+  parallel_for(n_chunks, opts->n_threads, count_libsvm_chunks, &ctx);
+  check_libsvm_chunks(filename, chunks, n_chunks, opts->line_offset);
+  for (c = 0; c < n_chunks; c++) {
+    chunks[c].row_offset = n_rows;
+    chunks[c].nz_offset = nnz;
+    n_rows += chunks[c].n_rows;
+    nnz += chunks[c].nnz;
+  }
+
+  shape[0] = n_rows;
+  shape[1] = ctx.n_labels;
+  labels = rb_narray_new(numo_cDFloat, 2, shape);
+  shape[0] = nnz;
+  data = rb_narray_new(numo_cDFloat, 1, shape);
+  indices = rb_narray_new(numo_cInt32, 1, shape);
+  shape[0] = n_rows + 1;
+  indptr = rb_narray_new(numo_cInt64, 1, shape);
+  ctx.labels = (double*)na_get_pointer_for_write(labels);
+  ctx.data = (double*)na_get_pointer_for_write(data);
+  ctx.indices = (int32_t*)na_get_pointer_for_write(indices);
+  ctx.indptr = (int64_t*)na_get_pointer_for_write(indptr);
+  ctx.indptr[0] = 0;
+
+  parallel_for(n_chunks, opts->n_threads, parse_libsvm_chunks, &ctx);
+  check_libsvm_chunks(filename, chunks, n_chunks, opts->line_offset);
+  for (c = 0; c < n_chunks; c++) {
+    if (chunks[c].max_index > max_index) max_index = chunks[c].max_index;
+    if (chunks[c].n_rows > 0 && !chunks[c].int_labels) int_labels = 0;
+  }
+
+  ALLOCV_END(chunks_buf);
+  return rb_ary_new_from_args(6, labels, int_labels ? Qtrue : Qfalse, data, indices, indptr, LONG2NUM(max_index));
+}
+
+/**
+ * @!visibility private
+ * Parse the libsvm format file. The file is mapped into memory, split into line-aligned chunks,
+ * and the chunks are parsed in parallel into the preallocated buffers of a matrix in CSR format.
+ *
+ * @overload parse_libsvm_file(filename, zero_based, n_threads) -> Array
+ *
+ * @param filename [String] The path to the libsvm format file.
+ * @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false).
+ * @param n_threads [Integer] The number of threads to parse the chunks.
+ * @return [Array] The array consisting of the labels (Numo::DFloat, shape: [n_samples, n_labels]),
+ *   the flag indicating whether all labels are integers, data (Numo::DFloat), indices (Numo::Int32),
+ *   and indptr (Numo::Int64) of the feature matrix, and the maximum feature index (-1 if no feature exists).
+ */
+static VALUE parse_libsvm_file(VALUE self, VALUE filename, VALUE zero_based, VALUE n_threads) {
+  libsvm_opts_t opts;
+
+  opts.zero_based = RTEST(zero_based);
+  opts.n_threads = NUM2INT(n_threads) > 0 ? NUM2INT(n_threads) : 1;
+  opts.line_offset = 0;
+  return with_mapped_file(filename, parse_libsvm_buffer, &opts);
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  char* buf;
+  size_t size;
+  VALUE source;
+  libsvm_opts_t* opts;
+} copied_string_t;
+
+/**
+ * @!visibility private
+ */
+static VALUE parse_copied_string(VALUE copied_) {
+  copied_string_t* copied = (copied_string_t*)copied_;
+  return parse_libsvm_buffer(copied->buf, copied->size, copied->source, copied->opts);
+}
+
+/**
+ * @!visibility private
+ */
+static VALUE release_copied_string(VALUE copied_) {
+  copied_string_t* copied = (copied_string_t*)copied_;
+  xfree(copied->buf);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ * Parse the lines of libsvm format in the string in the same way as parse_libsvm_file.
+ *
+ * @overload parse_libsvm_string(str, source, line_offset, zero_based, n_threads) -> Array
+ *
+ * @param str [String] The lines of libsvm format.
+ * @param source [String] The name of the source shown in the error messages.
+ * @param line_offset [Integer] The number of lines preceding the string in the source.
+ * @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false).
+ * @param n_threads [Integer] The number of threads to parse the chunks.
+ * @return [Array] The array with the same elements as parse_libsvm_file.
+ */
+static VALUE parse_libsvm_string(VALUE self, VALUE str, VALUE source, VALUE line_offset, VALUE zero_based, VALUE n_threads) {
+  libsvm_opts_t opts;
+  copied_string_t copied;
+  VALUE ret;
+
+  StringValue(str);
+  opts.zero_based = RTEST(zero_based);
+  opts.n_threads = NUM2INT(n_threads) > 0 ? NUM2INT(n_threads) : 1;
+  opts.line_offset = NUM2LONG(line_offset);
+  /* the contents are parsed on a private copy, since the string may be modified or moved by the other threads
+     while the worker threads run without the GVL. */
+  copied.size = (size_t)RSTRING_LEN(str);
+  copied.buf = ALLOC_N(char, copied.size > 0 ? copied.size : 1);
+  memcpy(copied.buf, RSTRING_PTR(str), copied.size);
+  copied.source = source;
+  copied.opts = &opts;
+  ret = rb_ensure(parse_copied_string, (VALUE)&copied, release_copied_string, (VALUE)&copied);
+  RB_GC_GUARD(str);
+  RB_GC_GUARD(source);
+  return ret;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  FILE* fp;
+  const double* labels;
+  const double* data;
+  const int32_t* indices;
+  const int64_t* indptr;
+  long n_samples;
+  long n_labels;
+  long n_features;
+  long index_offset;
+  int int_labels;
+  int int_values;
+  char* buf;
+  size_t len;
+  int error;
+} libsvm_writer_t;
+
+/**
+ * @!visibility private
+ * Format the integer into the buffer, and return the number of written characters.
+ */
+static int format_integer(char* out, int64_t val) {
+  char digits[24];
+  uint64_t u = val < 0 ? (uint64_t)(-(val + 1)) + 1 : (uint64_t)val;
+  int n = 0, len = 0;
+
+  do {
+    digits[n++] = (char)('0' + u % 10);
+    u /= 10;
+  } while (u > 0);
+  if (val < 0) out[len++] = '-';
+  while (n > 0) out[len++] = digits[--n];
+  return len;
+}
+
+/**
+ * @!visibility private
+ * Format the floating point number with the shortest representation that can be read back to the same value.
+ * The number is written as an integer if it is integral and the integer format is requested.
+ */
+static int format_number(char* out, const double val, const int as_integer) {
+  int len, prec;
+
+  if (as_integer && val >= -9.0e18 && val <= 9.0e18 && val == (double)(int64_t)val) {
+    return format_integer(out, (int64_t)val);
+  }
+  for (prec = 15; prec <= 17; prec++) {
+    len = snprintf(out, LIBSVM_MAX_TOKEN_LENGTH, "%.*g", prec, val);
+    if (prec == 17 || val != val || strtod(out, NULL) == val) break;
+  }
+  return len;
+}
+
+/**
+ * @!visibility private
+ */
+static void flush_libsvm_writer(libsvm_writer_t* writer) {
+  if (writer->len > 0 && fwrite(writer->buf, 1, writer->len, writer->fp) != writer->len) writer->error = errno;
+  writer->len = 0;
+}
+
+/**
+ * @!visibility private
+ */
+static void write_libsvm_element(libsvm_writer_t* writer, const long idx, const double val) {
+  char* out;
+
+  if (val == 0.0) return;
+  if (writer->len + 2 * LIBSVM_MAX_TOKEN_LENGTH > LIBSVM_WRITE_BUFFER_SIZE) flush_libsvm_writer(writer);
+  out = writer->buf + writer->len;
+  *out++ = ' ';
+  out += format_integer(out, idx + writer->index_offset);
+  *out++ = ':';
+  out += format_number(out, val, writer->int_values);
+  writer->len = out - writer->buf;
+}
+
+/**
+ * @!visibility private
+ */
+static void* write_libsvm_without_gvl(void* writer_) {
+  libsvm_writer_t* writer = (libsvm_writer_t*)writer_;
+  const long n_labels = writer->n_labels;
+  const long n_features = writer->n_features;
+  long i, j;
+  int64_t k;
+
+  for (i = 0; i < writer->n_samples && writer->error == 0; i++) {
+    for (j = 0; j < n_labels; j++) {
+      if (writer->len + 2 * LIBSVM_MAX_TOKEN_LENGTH > LIBSVM_WRITE_BUFFER_SIZE) flush_libsvm_writer(writer);
+      if (j > 0) writer->buf[writer->len++] = ',';
+      writer->len += format_number(writer->buf + writer->len, writer->labels[i * n_labels + j], writer->int_labels);
+    }
+    if (writer->indptr == NULL) {
+      for (j = 0; j < n_features; j++) write_libsvm_element(writer, j, writer->data[i * n_features + j]);
+    } else {
+      for (k = writer->indptr[i]; k < writer->indptr[i + 1]; k++) {
+        write_libsvm_element(writer, writer->indices[k], writer->data[k]);
+      }
+    }
+    writer->buf[writer->len++] = '\n';
+  }
+  flush_libsvm_writer(writer);
+  return NULL;
+}
+
+/**
+ * @!visibility private
+ * Write the samples and labels in the libsvm format. The lines are formatted into a large buffer
+ * without the GVL, and the buffer is written to the file whenever it is nearly full.
+ *
+ * @overload write_libsvm_file(filename, labels, data, indices, indptr, int_labels, int_values, zero_based) -> nil
+ *
+ * @param filename [String] The path to the output file.
+ * @param labels [Numo::DFloat] (shape: [n_samples, n_labels]) The contiguous labels or target values.
+ * @param data [Numo::DFloat] (shape: [n_samples, n_features] or [nnz])
+ *   The contiguous dense matrix, or the values of non-zero elements of the matrix in CSR format.
+ * @param indices [Numo::Int32/Nil] (shape: [nnz]) The column indices of non-zero elements, or nil for the dense matrix.
+ * @param indptr [Numo::Int64/Nil] (shape: [n_samples + 1]) The offsets of each row, or nil for the dense matrix.
+ * @param int_labels [Boolean] The flag indicating whether to write the labels as integers.
+ * @param int_values [Boolean] The flag indicating whether to write the feature values as integers.
+ * @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false).
+ * @return [Nil]
+ */
+static VALUE write_libsvm_file(VALUE self, VALUE filename, VALUE labels, VALUE data, VALUE indices, VALUE indptr,
+                               VALUE int_labels, VALUE int_values, VALUE zero_based) {
+  libsvm_writer_t writer;
+  VALUE buf_val = 0;
+  int error;
+
+  FilePathValue(filename);
+  writer.labels = (double*)na_get_pointer_for_read(labels);
+  writer.n_samples = (long)RNARRAY_SHAPE(labels)[0];
+  writer.n_labels = (long)RNARRAY_SHAPE(labels)[1];
+  writer.data = (double*)na_get_pointer_for_read(data);
+  if (NIL_P(indptr)) {
+    writer.indices = NULL;
+    writer.indptr = NULL;
+    writer.n_features = (long)RNARRAY_SHAPE(data)[1];
+  } else {
+    writer.indices = (int32_t*)na_get_pointer_for_read(indices);
+    writer.indptr = (int64_t*)na_get_pointer_for_read(indptr);
+    writer.n_features = 0;
+  }
+  writer.index_offset = RTEST(zero_based) ? 0 : 1;
+  writer.int_labels = RTEST(int_labels);
+  writer.int_values = RTEST(int_values);
+  writer.len = 0;
+  writer.error = 0;
+  writer.buf = ALLOCV_N(char, buf_val, LIBSVM_WRITE_BUFFER_SIZE);
+  writer.fp = fopen(StringValueCStr(filename), "wb");
+  if (writer.fp == NULL) {
+    ALLOCV_END(buf_val);
+    rb_sys_fail_str(filename);
+  }
+
+  rb_thread_call_without_gvl(write_libsvm_without_gvl, &writer, NULL, NULL);
+
+  error = writer.error;
+  if (fclose(writer.fp) != 0 && error == 0) error = errno;
+  ALLOCV_END(buf_val);
+  if (error != 0) rb_syserr_fail_str(error, filename);
+
+  RB_GC_GUARD(labels);
+  RB_GC_GUARD(data);
+  RB_GC_GUARD(indices);
+  RB_GC_GUARD(indptr);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ * The binary container consists of the header, the array entries, and the array contents aligned to 64 bytes.
+ * The header holds the magic string, the format version, the byte order mark, and the number of arrays.
+ * Each entry holds the name, type code, number of dimensions, shape, byte offset, and byte size of the array.
+ */
+#define BINARY_MAGIC "RUMALEDS"
+#define BINARY_VERSION 1
+#define BINARY_BYTE_ORDER_MARK 0x01020304
+#define BINARY_ALIGNMENT 64
+#define BINARY_HEADER_SIZE 24
+#define BINARY_NAME_LENGTH 32
+#define BINARY_MAX_NDIM 4
+#define BINARY_ENTRY_SIZE (BINARY_NAME_LENGTH + 8 + 8 * BINARY_MAX_NDIM + 16)
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  char name[BINARY_NAME_LENGTH];
+  uint32_t dtype;
+  uint32_t ndim;
+  int64_t shape[BINARY_MAX_NDIM];
+  int64_t offset;
+  int64_t nbytes;
+} binary_entry_t;
+
+/**
+ * @!visibility private
+ * Return the class of Numo::NArray and the element size for the type code, or Qnil for the unknown code.
+ */
+static VALUE binary_dtype_class(const uint32_t dtype, size_t* elsz) {
+  switch (dtype) {
+  case 1:
+    *elsz = 8;
+    return numo_cDFloat;
+  case 2:
+    *elsz = 4;
+    return numo_cSFloat;
+  case 3:
+    *elsz = 1;
+    return numo_cInt8;
+  case 4:
+    *elsz = 2;
+    return numo_cInt16;
+  case 5:
+    *elsz = 4;
+    return numo_cInt32;
+  case 6:
+    *elsz = 8;
+    return numo_cInt64;
+  case 7:
+    *elsz = 1;
+    return numo_cUInt8;
+  case 8:
+    *elsz = 2;
+    return numo_cUInt16;
+  case 9:
+    *elsz = 4;
+    return numo_cUInt32;
+  case 10:
+    *elsz = 8;
+    return numo_cUInt64;
+  default:
+    return Qnil;
+  }
+}
+
+/**
+ * @!visibility private
+ * Return the type code of the array, or zero if the type is not supported.
+ */
+static uint32_t binary_dtype_code(VALUE arr) {
+  size_t elsz;
+  uint32_t dtype;
+
+  for (dtype = 1; !NIL_P(binary_dtype_class(dtype, &elsz)); dtype++) {
+    if (CLASS_OF(arr) == binary_dtype_class(dtype, &elsz)) return dtype;
+  }
+  return 0;
+}
+
+/**
+ * @!visibility private
+ */
+static size_t align_binary_offset(const size_t offset) {
+  return (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+}
+
+/**
+ * @!visibility private
+ */
+static void pack_binary_entry(char* out, const binary_entry_t* entry) {
+  memcpy(out, entry->name, BINARY_NAME_LENGTH);
+  out += BINARY_NAME_LENGTH;
+  memcpy(out, &entry->dtype, 4);
+  memcpy(out + 4, &entry->ndim, 4);
+  memcpy(out + 8, entry->shape, 8 * BINARY_MAX_NDIM);
+  out += 8 + 8 * BINARY_MAX_NDIM;
+  memcpy(out, &entry->offset, 8);
+  memcpy(out + 8, &entry->nbytes, 8);
+}
+
+/**
+ * @!visibility private
+ */
+static void unpack_binary_entry(binary_entry_t* entry, const char* in) {
+  memcpy(entry->name, in, BINARY_NAME_LENGTH);
+  entry->name[BINARY_NAME_LENGTH - 1] = '\0';
+  in += BINARY_NAME_LENGTH;
+  memcpy(&entry->dtype, in, 4);
+  memcpy(&entry->ndim, in + 4, 4);
+  memcpy(entry->shape, in + 8, 8 * BINARY_MAX_NDIM);
+  in += 8 + 8 * BINARY_MAX_NDIM;
+  memcpy(&entry->offset, in, 8);
+  memcpy(&entry->nbytes, in + 8, 8);
+}
+
+/**
+ * @!visibility private
+ * Write the contiguous arrays into the binary container.
+ *
+ * @overload write_binary_arrays(filename, names, arrays) -> nil
+ *
+ * @param filename [String] The path to the output file.
+ * @param names [Array<String>] The names of arrays.
+ * @param arrays [Array<Numo::NArray>] The contiguous arrays of Numo::DFloat, Numo::SFloat, or integer types.
+ * @return [Nil]
+ */
+static VALUE write_binary_arrays(VALUE self, VALUE filename, VALUE names, VALUE arrays) {
+  const long n_arrays = RARRAY_LEN(arrays);
+  const size_t header_size = align_binary_offset(BINARY_HEADER_SIZE + n_arrays * BINARY_ENTRY_SIZE);
+  binary_entry_t* entries;
+  VALUE entries_buf = 0;
+  VALUE header_buf = 0;
+  VALUE name, arr;
+  char* header;
+  size_t elsz, offset = header_size;
+  uint32_t u32;
+  long i, d;
+  int error = 0;
+  FILE* fp;
+
+  FilePathValue(filename);
+  Check_Type(names, T_ARRAY);
+  Check_Type(arrays, T_ARRAY);
+  if (RARRAY_LEN(names) != n_arrays) rb_raise(rb_eArgError, "Expect names and arrays to have the same size");
+
+  entries = ALLOCV_N(binary_entry_t, entries_buf, n_arrays);
+  header = ALLOCV_N(char, header_buf, header_size);
+  memset(entries, 0, n_arrays * sizeof(binary_entry_t));
+  memset(header, 0, header_size);
+  for (i = 0; i < n_arrays; i++) {
+    name = rb_ary_entry(names, i);
+    arr = rb_ary_entry(arrays, i);
+    StringValue(name);
+    if (RSTRING_LEN(name) >= BINARY_NAME_LENGTH) rb_raise(rb_eArgError, "Expect name of array to be shorter than 32 bytes");
+    if (!RTEST(rb_obj_is_kind_of(arr, numo_cNArray)) || (entries[i].dtype = binary_dtype_code(arr)) == 0) {
+      rb_raise(rb_eTypeError, "Expect %" PRIsVALUE " to be Numo::DFloat, Numo::SFloat, or Numo::NArray of integer type", name);
+    }
+    if (RNARRAY_NDIM(arr) < 1 || RNARRAY_NDIM(arr) > BINARY_MAX_NDIM) {
+      rb_raise(rb_eArgError, "Expect %" PRIsVALUE " to have one to four dimensions", name);
+    }
+    memcpy(entries[i].name, RSTRING_PTR(name), RSTRING_LEN(name));
+    binary_dtype_class(entries[i].dtype, &elsz);
+    entries[i].ndim = (uint32_t)RNARRAY_NDIM(arr);
+    entries[i].nbytes = (int64_t)elsz;
+    for (d = 0; d < (long)entries[i].ndim; d++) {
+      entries[i].shape[d] = (int64_t)RNARRAY_SHAPE(arr)[d];
+      entries[i].nbytes *= entries[i].shape[d];
+    }
+    entries[i].offset = (int64_t)offset;
+    offset = align_binary_offset(offset + (size_t)entries[i].nbytes);
+    pack_binary_entry(header + BINARY_HEADER_SIZE + i * BINARY_ENTRY_SIZE, &entries[i]);
+  }
+  memcpy(header, BINARY_MAGIC, 8);
+  u32 = BINARY_VERSION;
+  memcpy(header + 8, &u32, 4);
+  u32 = BINARY_BYTE_ORDER_MARK;
+  memcpy(header + 12, &u32, 4);
+  u32 = (uint32_t)n_arrays;
+  memcpy(header + 16, &u32, 4);
+
+  fp = fopen(StringValueCStr(filename), "wb");
+  if (fp == NULL) rb_sys_fail_str(filename);
+  if (fwrite(header, 1, header_size, fp) != header_size) error = errno;
+  offset = header_size;
+  for (i = 0; i < n_arrays && error == 0; i++) {
+    if (entries[i].nbytes > 0) {
+      arr = rb_ary_entry(arrays, i);
+      if (fwrite(na_get_pointer_for_read(arr), 1, (size_t)entries[i].nbytes, fp) != (size_t)entries[i].nbytes) error = errno;
+    }
+    offset += (size_t)entries[i].nbytes;
+    /* pad the contents with zeros for the alignment of the next array. */
+    memset(header, 0, BINARY_ALIGNMENT);
+    if (error == 0 && fwrite(header, 1, align_binary_offset(offset) - offset, fp) != align_binary_offset(offset) - offset) {
+      error = errno;
+    }
+    offset = align_binary_offset(offset);
+  }
+  if (fclose(fp) != 0 && error == 0) error = errno;
+  ALLOCV_END(entries_buf);
+  ALLOCV_END(header_buf);
+  if (error != 0) rb_syserr_fail_str(error, filename);
+
+  RB_GC_GUARD(names);
+  RB_GC_GUARD(arrays);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  VALUE ranges;
+  int shapes_only;
+} binary_read_opts_t;
+
+/**
+ * @!visibility private
+ * Unpack the i-th entry and check that the contents of the array fit in the buffer.
+ */
+static VALUE load_binary_entry(const char* buf, const size_t size, VALUE filename, const uint32_t i, binary_entry_t* entry,
+                               size_t* shape, size_t* elsz) {
+  VALUE klass;
+  size_t nbytes;
+  uint32_t d;
+
+  unpack_binary_entry(entry, buf + BINARY_HEADER_SIZE + i * BINARY_ENTRY_SIZE);
+  klass = binary_dtype_class(entry->dtype, elsz);
+  if (NIL_P(klass) || entry->ndim < 1 || entry->ndim > BINARY_MAX_NDIM) {
+    rb_raise(rb_eArgError, "Invalid array entry %s in %" PRIsVALUE, entry->name, filename);
+  }
+  nbytes = *elsz;
+  for (d = 0; d < entry->ndim; d++) {
+    if (entry->shape[d] < 0 || (entry->shape[d] > 0 && nbytes > SIZE_MAX / (size_t)entry->shape[d])) {
+      rb_raise(rb_eArgError, "Invalid array entry %s in %" PRIsVALUE, entry->name, filename);
+    }
+    shape[d] = (size_t)entry->shape[d];
+    nbytes *= shape[d];
+  }
+  if (entry->offset < 0 || (size_t)entry->nbytes != nbytes || (size_t)entry->offset > size ||
+      nbytes > size - (size_t)entry->offset) {
+    rb_raise(rb_eArgError, "Invalid array entry %s in %" PRIsVALUE, entry->name, filename);
+  }
+  return klass;
+}
+
+/**
+ * @!visibility private
+ */
+static VALUE read_binary_buffer(const char* buf, const size_t size, VALUE filename, void* opts_) {
+  const binary_read_opts_t* opts = (binary_read_opts_t*)opts_;
+  binary_entry_t entry;
+  VALUE arrays = rb_hash_new();
+  VALUE klass, arr, name, range, shape_ary;
+  size_t shape[BINARY_MAX_NDIM];
+  size_t elsz, row_bytes;
+  long row_begin, row_end;
+  uint32_t version, bom, n_arrays, i, d;
+
+  if (size < BINARY_HEADER_SIZE || memcmp(buf, BINARY_MAGIC, 8) != 0) {
+    rb_raise(rb_eArgError, "%" PRIsVALUE " is not a binary dataset file", filename);
+  }
+  memcpy(&version, buf + 8, 4);
+  memcpy(&bom, buf + 12, 4);
+  memcpy(&n_arrays, buf + 16, 4);
+  if (version != BINARY_VERSION) rb_raise(rb_eArgError, "Unsupported version %u of %" PRIsVALUE, version, filename);
+  if (bom != BINARY_BYTE_ORDER_MARK) rb_raise(rb_eArgError, "%" PRIsVALUE " was written in a different byte order", filename);
+  if (size < BINARY_HEADER_SIZE + (size_t)n_arrays * BINARY_ENTRY_SIZE) {
+    rb_raise(rb_eArgError, "%" PRIsVALUE " is truncated", filename);
+  }
+
+  for (i = 0; i < n_arrays; i++) {
+    klass = load_binary_entry(buf, size, filename, i, &entry, shape, &elsz);
+    name = rb_str_new_cstr(entry.name);
+    if (opts->shapes_only) {
+      shape_ary = rb_ary_new_capa(entry.ndim);
+      for (d = 0; d < entry.ndim; d++) rb_ary_push(shape_ary, SIZET2NUM(shape[d]));
+      rb_hash_aset(arrays, name, shape_ary);
+      continue;
+    }
+    row_begin = 0;
+    row_end = (long)shape[0];
+    if (!NIL_P(opts->ranges)) {
+      /* copy only the rows in the given range along the first axis. */
+      range = rb_hash_lookup(opts->ranges, name);
+      if (NIL_P(range)) continue;
+      row_begin = NUM2LONG(rb_ary_entry(range, 0));
+      row_end = NUM2LONG(rb_ary_entry(range, 1));
+      if (row_begin < 0 || row_end < row_begin || row_end > (long)shape[0]) {
+        rb_raise(rb_eArgError, "Expect the range of rows to be within the array %s", entry.name);
+      }
+    }
+    row_bytes = elsz;
+    for (d = 1; d < entry.ndim; d++) row_bytes *= shape[d];
+    shape[0] = (size_t)(row_end - row_begin);
+    arr = rb_narray_new(klass, (int)entry.ndim, shape);
+    if (shape[0] * row_bytes > 0) {
+      memcpy(na_get_pointer_for_write(arr), buf + entry.offset + row_begin * row_bytes, shape[0] * row_bytes);
+    }
+    rb_hash_aset(arrays, name, arr);
+  }
+
+  return arrays;
+}
+
+/**
+ * @!visibility private
+ * Read the arrays from the binary container. The file is mapped into memory,
+ * and the contents of each array are copied into the new array at once without any parsing.
+ *
+ * @overload read_binary_arrays(filename) -> Hash
+ *
+ * @param filename [String] The path to the binary dataset file.
+ * @return [Hash{String=>Numo::NArray}] The arrays keyed by their names.
+ */
+static VALUE read_binary_arrays(VALUE self, VALUE filename) {
+  binary_read_opts_t opts;
+
+  opts.ranges = Qnil;
+  opts.shapes_only = 0;
+  return with_mapped_file(filename, read_binary_buffer, &opts);
+}
+
+/**
+ * @!visibility private
+ * Read the shapes of arrays from the binary container without copying the contents.
+ *
+ * @overload read_binary_shapes(filename) -> Hash
+ *
+ * @param filename [String] The path to the binary dataset file.
+ * @return [Hash{String=>Array<Integer>}] The shapes of arrays keyed by their names.
+ */
+static VALUE read_binary_shapes(VALUE self, VALUE filename) {
+  binary_read_opts_t opts;
+
+  opts.ranges = Qnil;
+  opts.shapes_only = 1;
+  return with_mapped_file(filename, read_binary_buffer, &opts);
+}
+
+/**
+ * @!visibility private
+ * Read the rows in the given ranges of the arrays from the binary container.
+ * Only the pages holding the requested rows are touched, so that a large file can be read in pieces.
+ *
+ * @overload read_binary_rows(filename, ranges) -> Hash
+ *
+ * @param filename [String] The path to the binary dataset file.
+ * @param ranges [Hash{String=>Array<Integer>}] The beginning and end of rows along the first axis keyed by the names of arrays.
+ * @return [Hash{String=>Numo::NArray}] The arrays consisting of the requested rows keyed by their names.
+ */
+static VALUE read_binary_rows(VALUE self, VALUE filename, VALUE ranges) {
+  binary_read_opts_t opts;
+  VALUE ret;
+
+  Check_Type(ranges, T_HASH);
+  opts.ranges = ranges;
+  opts.shapes_only = 0;
+  ret = with_mapped_file(filename, read_binary_buffer, &opts);
+  RB_GC_GUARD(ranges);
+  return ret;
+}
+
+void init_dataset_module() {
+  VALUE mDataset = rb_define_module_under(mRumale, "Dataset");
+  /**
+   * Document-module: Rumale::Dataset::ExtDataset
+   * @!visibility private
+   * The mixin module consisting of extension methods for Dataset module.
+   * This module is used internally.
+   */
+  VALUE mExtDataset = rb_define_module_under(mDataset, "ExtDataset");
+
+  rb_define_private_method(mExtDataset, "parse_libsvm_file", parse_libsvm_file, 3);
+  rb_define_private_method(mExtDataset, "parse_libsvm_string", parse_libsvm_string, 5);
+  rb_define_private_method(mExtDataset, "write_libsvm_file", write_libsvm_file, 8);
+  rb_define_private_method(mExtDataset, "write_binary_arrays", write_binary_arrays, 3);
+  rb_define_private_method(mExtDataset, "read_binary_arrays", read_binary_arrays, 1);
+  rb_define_private_method(mExtDataset, "read_binary_shapes", read_binary_shapes, 1);
+  rb_define_private_method(mExtDataset, "read_binary_rows", read_binary_rows, 2);
+}
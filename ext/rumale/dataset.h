@@ -0,0 +1,30 @@
+#ifndef RUMALE_DATASET_H
+#define RUMALE_DATASET_H 1
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <ruby.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+#include "parallel.h"
+
+void init_dataset_module();
+
+#endif /* RUMALE_DATASET_H */
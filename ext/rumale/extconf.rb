@@ -28,4 +28,9 @@ if RUBY_PLATFORM =~ /mswin|cygwin|mingw/
   end
 end
 
+have_library('pthread')
+have_header('pthread.h')
+have_header('unistd.h')
+have_header('sys/mman.h')
+
 create_makefile('rumale/rumaleext')
@@ -0,0 +1,519 @@
+#include "feature_extraction.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+static inline uint32_t rotl32(const uint32_t x, const int r) { return (x << r) | (x >> (32 - r)); }
+
+static inline uint32_t fmix32(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+/**
+ * @!visibility private
+ * Calculate 32-bit MurmurHash3 (x86_32) of the given bytes.
+ */
+static uint32_t murmurhash3_32(const uint8_t* key, const long len, const uint32_t seed) {
+  const uint32_t c1 = 0xcc9e2d51;
+  const uint32_t c2 = 0x1b873593;
+  const long n_blocks = len / 4;
+  const uint8_t* tail = key + n_blocks * 4;
+  uint32_t h = seed;
+  uint32_t k;
+  long i;
+
+  for (i = 0; i < n_blocks; i++) {
+    k = (uint32_t)key[i * 4] | ((uint32_t)key[i * 4 + 1] << 8) | ((uint32_t)key[i * 4 + 2] << 16) |
+        ((uint32_t)key[i * 4 + 3] << 24);
+    k *= c1;
+    k = rotl32(k, 15);
+    k *= c2;
+    h ^= k;
+    h = rotl32(h, 13);
+    h = h * 5 + 0xe6546b64;
+  }
+
+  k = 0;
+  switch (len & 3) {
+  case 3:
+    k ^= (uint32_t)tail[2] << 16;
+    /* fall through */
+  case 2:
+    k ^= (uint32_t)tail[1] << 8;
+    /* fall through */
+  case 1:
+    k ^= (uint32_t)tail[0];
+    k *= c1;
+    k = rotl32(k, 15);
+    k *= c2;
+    h ^= k;
+  }
+
+  h ^= (uint32_t)len;
+  return fmix32(h);
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int64_t index;
+  long order;
+  double value;
+} feature_entry_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  feature_entry_t* entries;
+  long n_entries;
+  VALUE buf;
+  /* for FeatureHasher */
+  int64_t n_features;
+  int alternate_sign;
+  /* for HashVectorizer */
+  VALUE separator;
+  VALUE vocabulary;
+  VALUE feature_names;
+} encode_features_args_t;
+
+/**
+ * @!visibility private
+ * Return the string representation of feature name without creating new string for string and symbol.
+ */
+static VALUE feature_name_str(VALUE name) {
+  if (RB_TYPE_P(name, T_STRING)) {
+    return name;
+  }
+  if (RB_TYPE_P(name, T_SYMBOL)) {
+    return rb_sym2str(name);
+  }
+  return rb_obj_as_string(name);
+}
+
+/**
+ * @!visibility private
+ * Join the feature name and the categorical value with the separator into the reusable buffer.
+ */
+static VALUE join_feature_name(VALUE buf, VALUE key, VALUE separator, VALUE val) {
+  rb_str_set_len(buf, 0);
+  rb_str_buf_append(buf, feature_name_str(key));
+  rb_str_buf_append(buf, separator);
+  rb_str_buf_append(buf, val);
+  return buf;
+}
+
+/**
+ * @!visibility private
+ */
+static void push_feature_entry(encode_features_args_t* args, const int64_t index, const double value) {
+  args->entries[args->n_entries].index = index;
+  args->entries[args->n_entries].order = args->n_entries;
+  args->entries[args->n_entries].value = value;
+  args->n_entries++;
+}
+
+static int compare_feature_entry(const void* a_, const void* b_) {
+  const feature_entry_t* a = (const feature_entry_t*)a_;
+  const feature_entry_t* b = (const feature_entry_t*)b_;
+  if (a->index != b->index) {
+    return a->index < b->index ? -1 : 1;
+  }
+  return a->order < b->order ? -1 : (a->order > b->order ? 1 : 0);
+}
+
+/**
+ * @!visibility private
+ * Encode the array of feature-value hash to the arrays of sparse matrix in CSR format.
+ * The given function pushes the column indices and values of features in each hash.
+ * When the same column index is pushed several times in a sample, the value pushed last is used,
+ * and the elements with zero value are not stored.
+ */
+static VALUE encode_features(VALUE x, int (*each_pair)(VALUE, VALUE, VALUE), encode_features_args_t* args) {
+  long n_samples;
+  long max_nnz = 0;
+  long nnz = 0;
+  long i, j;
+  feature_entry_t* entries;
+  size_t shape[1];
+  VALUE entries_buf = 0;
+  VALUE row;
+  VALUE data;
+  VALUE indices;
+  VALUE indptr;
+  double* data_ptr;
+  int32_t* indices_ptr;
+  int64_t* indptr_ptr;
+
+  Check_Type(x, T_ARRAY);
+  n_samples = RARRAY_LEN(x);
+  for (i = 0; i < n_samples; i++) {
+    row = rb_ary_entry(x, i);
+    Check_Type(row, T_HASH);
+    max_nnz += RHASH_SIZE(row);
+  }
+
+  entries = ALLOCV_N(feature_entry_t, entries_buf, max_nnz > 0 ? max_nnz : 1);
+  args->buf = rb_str_buf_new(64);
+
+  shape[0] = n_samples + 1;
+  indptr = rb_narray_new(numo_cInt64, 1, shape);
+  indptr_ptr = (int64_t*)na_get_pointer_for_write(indptr);
+  indptr_ptr[0] = 0;
+  for (i = 0; i < n_samples; i++) {
+    /* The entries of each row are sorted by index and deduplicated in place just behind the previous rows. */
+    args->entries = entries + nnz;
+    args->n_entries = 0;
+    rb_hash_foreach(rb_ary_entry(x, i), each_pair, (VALUE)args);
+    qsort(args->entries, args->n_entries, sizeof(feature_entry_t), compare_feature_entry);
+    for (j = 0; j < args->n_entries; j++) {
+      if (j + 1 < args->n_entries && args->entries[j + 1].index == args->entries[j].index) {
+        continue;
+      }
+      if (args->entries[j].value == 0.0) {
+        continue;
+      }
+      entries[nnz++] = args->entries[j];
+    }
+    indptr_ptr[i + 1] = nnz;
+  }
+
+  shape[0] = nnz;
+  data = rb_narray_new(numo_cDFloat, 1, shape);
+  indices = rb_narray_new(numo_cInt32, 1, shape);
+  data_ptr = (double*)na_get_pointer_for_write(data);
+  indices_ptr = (int32_t*)na_get_pointer_for_write(indices);
+  for (i = 0; i < nnz; i++) {
+    data_ptr[i] = entries[i].value;
+    indices_ptr[i] = (int32_t)entries[i].index;
+  }
+
+  ALLOCV_END(entries_buf);
+  RB_GC_GUARD(args->buf);
+  return rb_ary_new3(3, data, indices, indptr);
+}
+
+/**
+ * @!visibility private
+ */
+static int hash_features_each_pair(VALUE key, VALUE val, VALUE args_) {
+  encode_features_args_t* args = (encode_features_args_t*)args_;
+  VALUE name;
+  double value;
+  int32_t h;
+  int64_t index;
+
+  if (RB_TYPE_P(val, T_STRING)) {
+    name = join_feature_name(args->buf, key, args->separator, val);
+    value = 1.0;
+  } else {
+    name = feature_name_str(key);
+    value = NUM2DBL(val);
+  }
+  if (value == 0.0) {
+    return ST_CONTINUE;
+  }
+
+  h = (int32_t)murmurhash3_32((const uint8_t*)RSTRING_PTR(name), RSTRING_LEN(name), 0);
+  index = (h < 0 ? -(int64_t)h : (int64_t)h) % args->n_features;
+  push_feature_entry(args, index, args->alternate_sign && h < 0 ? -value : value);
+
+  return ST_CONTINUE;
+}
+
+/**
+ * @!visibility private
+ * Hash the feature names in the array of feature-value hash to column indices of sparse matrix in CSR format.
+ * The feature names are hashed with signed 32-bit MurmurHash3 with zero seed.
+ * If a feature has a string value, the string joined the name and the value with '=' is hashed, and its value is one.
+ * When the hashes of features in a sample collide, the value of the feature appearing later is used.
+ *
+ * @overload hash_features(x, n_features, alternate_sign) -> Array
+ *
+ * @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
+ * @param n_features [Integer] The number of features of encoded samples.
+ * @param alternate_sign [Boolean] The flag indicating whether to reflect the sign of the hash value to the feature value.
+ * @return [Array<Numo::NArray>] The data (Numo::DFloat), indices (Numo::Int32), and indptr (Numo::Int64) of CSR matrix.
+ */
+static VALUE hash_features(VALUE self, VALUE x, VALUE n_features, VALUE alternate_sign) {
+  encode_features_args_t args;
+  VALUE res;
+
+  memset(&args, 0, sizeof(args));
+  args.n_features = NUM2LL(n_features);
+  args.alternate_sign = RTEST(alternate_sign);
+  args.separator = rb_str_new_cstr("=");
+  res = encode_features(x, hash_features_each_pair, &args);
+
+  RB_GC_GUARD(args.separator);
+  return res;
+}
+
+/**
+ * @!visibility private
+ * Return the key of vocabulary for the feature. The categorical feature is interned as the symbol
+ * of the string joined the name and the value. If create is false and the symbol does not exist yet, nil is returned.
+ * The new symbol is interned from a fresh string as a dynamic symbol, so that it can be garbage collected
+ * like the symbol given by String#to_sym once the vocabulary is released.
+ */
+static VALUE vocabulary_key(encode_features_args_t* args, VALUE key, VALUE val, const int create) {
+  VALUE name;
+  VALUE sym;
+
+  if (!RB_TYPE_P(val, T_STRING)) {
+    return key;
+  }
+
+  name = join_feature_name(args->buf, key, args->separator, val);
+  sym = rb_check_symbol_cstr(RSTRING_PTR(name), RSTRING_LEN(name), rb_enc_get(name));
+  if (create && NIL_P(sym)) {
+    sym = rb_str_intern(rb_enc_str_new(RSTRING_PTR(name), RSTRING_LEN(name), rb_enc_get(name)));
+  }
+  return sym;
+}
+
+/**
+ * @!visibility private
+ */
+static int build_vocabulary_each_pair(VALUE key, VALUE val, VALUE args_) {
+  encode_features_args_t* args = (encode_features_args_t*)args_;
+  VALUE fname = vocabulary_key(args, key, val, 1);
+
+  if (rb_hash_lookup2(args->vocabulary, fname, Qundef) == Qundef) {
+    rb_hash_aset(args->vocabulary, fname, LONG2NUM(RARRAY_LEN(args->feature_names)));
+    rb_ary_push(args->feature_names, fname);
+  }
+
+  return ST_CONTINUE;
+}
+
+/**
+ * @!visibility private
+ * Build the vocabulary from the array of feature-value hash in order of appearance.
+ * The categorical feature names are interned as symbols, and a string is created only for the name not interned yet.
+ *
+ * @overload build_vocabulary(x, separator) -> Array
+ *
+ * @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
+ * @param separator [String] The separator string used for constructing new feature names for categorical feature.
+ * @return [Array] The feature names (Array) and the vocabulary (Hash).
+ */
+static VALUE build_vocabulary(VALUE self, VALUE x, VALUE separator) {
+  encode_features_args_t args;
+  long i, n_samples;
+
+  Check_Type(x, T_ARRAY);
+  StringValue(separator);
+  memset(&args, 0, sizeof(args));
+  args.separator = separator;
+  args.buf = rb_str_buf_new(64);
+  args.vocabulary = rb_hash_new();
+  args.feature_names = rb_ary_new();
+
+  n_samples = RARRAY_LEN(x);
+  for (i = 0; i < n_samples; i++) {
+    rb_hash_foreach(rb_check_hash_type(rb_ary_entry(x, i)), build_vocabulary_each_pair, (VALUE)&args);
+  }
+
+  RB_GC_GUARD(args.buf);
+  return rb_ary_new3(2, args.feature_names, args.vocabulary);
+}
+
+/**
+ * @!visibility private
+ */
+static int vectorize_features_each_pair(VALUE key, VALUE val, VALUE args_) {
+  encode_features_args_t* args = (encode_features_args_t*)args_;
+  const int categorical = RB_TYPE_P(val, T_STRING);
+  VALUE fname = vocabulary_key(args, key, val, 0);
+  VALUE index;
+
+  if (NIL_P(fname) && categorical) {
+    return ST_CONTINUE;
+  }
+  index = rb_hash_lookup2(args->vocabulary, fname, Qundef);
+  if (index == Qundef) {
+    return ST_CONTINUE;
+  }
+  push_feature_entry(args, NUM2LL(index), categorical ? 1.0 : NUM2DBL(val));
+
+  return ST_CONTINUE;
+}
+
+/**
+ * @!visibility private
+ * Encode the array of feature-value hash to the arrays of sparse matrix in CSR format with the vocabulary.
+ * The features not included in the vocabulary are ignored.
+ *
+ * @overload vectorize_features(x, vocabulary, separator) -> Array
+ *
+ * @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
+ * @param vocabulary [Hash] The hash consisting of pairs of feature names and indices.
+ * @param separator [String] The separator string used for constructing new feature names for categorical feature.
+ * @return [Array<Numo::NArray>] The data (Numo::DFloat), indices (Numo::Int32), and indptr (Numo::Int64) of CSR matrix.
+ */
+static VALUE vectorize_features(VALUE self, VALUE x, VALUE vocabulary, VALUE separator) {
+  encode_features_args_t args;
+
+  Check_Type(vocabulary, T_HASH);
+  StringValue(separator);
+  memset(&args, 0, sizeof(args));
+  args.separator = separator;
+  args.vocabulary = vocabulary;
+
+  return encode_features(x, vectorize_features_each_pair, &args);
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_csr_document_frequency(na_loop_t const* lp) {
+  const double* data = (double*)NDL_PTR(lp, 0);
+  const int32_t* indices = (int32_t*)NDL_PTR(lp, 1);
+  double* df = (double*)NDL_PTR(lp, 2);
+  const long nnz = NDL_SHAPE(lp, 0)[0];
+  long j;
+
+  for (j = 0; j < nnz; j++) {
+    if (data[j] > 0.0) {
+      df[indices[j]] += 1.0;
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Count the number of samples containing each feature in sparse matrix in CSR format.
+ *
+ * @overload csr_document_frequency(data, indices, df) -> nil
+ *
+ * @param data [Numo::DFloat] (shape: [nnz]) The non-zero elements.
+ * @param indices [Numo::Int32] (shape: [nnz]) The column indices of non-zero elements.
+ * @param df [Numo::DFloat] (shape: [n_features]) The zero-filled buffer to store the document frequencies.
+ * @return [Nil]
+ */
+static VALUE csr_document_frequency(VALUE self, VALUE data, VALUE indices, VALUE df) {
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 1}, {numo_cInt32, 1}, {numo_cDFloat, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_csr_document_frequency, NO_LOOP, 3, 0, ain, 0};
+  na_ndloop(&ndf, 3, data, indices, df);
+  RB_GC_GUARD(df);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int sublinear_tf;
+  int use_idf;
+  int norm;
+} tfidf_opts;
+/**
+ * @!visibility private
+ */
+static void iter_csr_tfidf(na_loop_t const* lp) {
+  const tfidf_opts* opts = (tfidf_opts*)lp->opt_ptr;
+  double* data = (double*)NDL_PTR(lp, 0);
+  const int32_t* indices = (int32_t*)NDL_PTR(lp, 1);
+  const int64_t* indptr = (int64_t*)NDL_PTR(lp, 2);
+  const double* idf = opts->use_idf ? (double*)NDL_PTR(lp, 3) : NULL;
+  const long n_samples = NDL_SHAPE(lp, 2)[0] - 1;
+  long i;
+  int64_t j;
+  double norm;
+
+  for (i = 0; i < n_samples; i++) {
+    norm = 0.0;
+    for (j = indptr[i]; j < indptr[i + 1]; j++) {
+      if (opts->sublinear_tf && data[j] != 0.0) {
+        data[j] = log(data[j]) + 1.0;
+      }
+      if (idf != NULL) {
+        data[j] *= idf[indices[j]];
+      }
+      norm += opts->norm == 2 ? data[j] * data[j] : fabs(data[j]);
+    }
+    if (opts->norm == 0) {
+      continue;
+    }
+    if (opts->norm == 2) {
+      norm = sqrt(norm);
+    }
+    if (norm == 0.0) {
+      continue;
+    }
+    for (j = indptr[i]; j < indptr[i + 1]; j++) {
+      data[j] /= norm;
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Transform the elements of sparse matrix in CSR format to the tf-idf representation in place.
+ *
+ * @overload csr_tfidf(data, indices, indptr, idf, sublinear_tf, norm) -> nil
+ *
+ * @param data [Numo::DFloat] (shape: [nnz]) The non-zero elements to be transformed.
+ * @param indices [Numo::Int32] (shape: [nnz]) The column indices of non-zero elements.
+ * @param indptr [Numo::Int64] (shape: [n_samples + 1]) The offsets of each row in data and indices.
+ * @param idf [Numo::DFloat/Nil] (shape: [n_features]) The inverse document frequencies.
+ *   If nil is given, idf weighting is not performed.
+ * @param sublinear_tf [Boolean] The flag indicating whether to perform subliner tf scaling by 1 + log(tf).
+ * @param norm [String] The normalization method to be used ('l1', 'l2' and 'none').
+ * @return [Nil]
+ */
+static VALUE csr_tfidf(VALUE self, VALUE data, VALUE indices, VALUE indptr, VALUE idf, VALUE sublinear_tf, VALUE norm) {
+  ndfunc_arg_in_t ain[4] = {{numo_cDFloat, 1}, {numo_cInt32, 1}, {numo_cInt64, 1}, {numo_cDFloat, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_csr_tfidf, NO_LOOP, NIL_P(idf) ? 3 : 4, 0, ain, 0};
+  tfidf_opts opts = {RTEST(sublinear_tf), !NIL_P(idf), 0};
+
+  if (strcmp(StringValueCStr(norm), "l2") == 0) {
+    opts.norm = 2;
+  } else if (strcmp(StringValueCStr(norm), "l1") == 0) {
+    opts.norm = 1;
+  }
+
+  if (NIL_P(idf)) {
+    na_ndloop3(&ndf, &opts, 3, data, indices, indptr);
+  } else {
+    na_ndloop3(&ndf, &opts, 4, data, indices, indptr, idf);
+  }
+
+  RB_GC_GUARD(data);
+  return Qnil;
+}
+
+void init_feature_extraction_module() {
+  VALUE mFeatureExtraction = rb_define_module_under(mRumale, "FeatureExtraction");
+  /**
+   * Document-module: Rumale::FeatureExtraction::ExtFeatureHasher
+   * @!visibility private
+   * The mixin module consisting of extension method for FeatureHasher class.
+   * This module is used internally.
+   */
+  VALUE mExtFeatureHasher = rb_define_module_under(mFeatureExtraction, "ExtFeatureHasher");
+  /**
+   * Document-module: Rumale::FeatureExtraction::ExtHashVectorizer
+   * @!visibility private
+   * The mixin module consisting of extension methods for HashVectorizer class.
+   * This module is used internally.
+   */
+  VALUE mExtHashVectorizer = rb_define_module_under(mFeatureExtraction, "ExtHashVectorizer");
+  /**
+   * Document-module: Rumale::FeatureExtraction::ExtTfidfTransformer
+   * @!visibility private
+   * The mixin module consisting of extension methods for TfidfTransformer class.
+   * This module is used internally.
+   */
+  VALUE mExtTfidfTransformer = rb_define_module_under(mFeatureExtraction, "ExtTfidfTransformer");
+
+  rb_define_private_method(mExtFeatureHasher, "hash_features", hash_features, 3);
+  rb_define_private_method(mExtHashVectorizer, "build_vocabulary", build_vocabulary, 2);
+  rb_define_private_method(mExtHashVectorizer, "vectorize_features", vectorize_features, 3);
+  rb_define_private_method(mExtTfidfTransformer, "csr_document_frequency", csr_document_frequency, 3);
+  rb_define_private_method(mExtTfidfTransformer, "csr_tfidf", csr_tfidf, 6);
+}
@@ -0,0 +1,17 @@
+#ifndef RUMALE_FEATURE_EXTRACTION_H
+#define RUMALE_FEATURE_EXTRACTION_H 1
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ruby.h>
+#include <ruby/encoding.h>
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+void init_feature_extraction_module();
+
+#endif /* RUMALE_FEATURE_EXTRACTION_H */
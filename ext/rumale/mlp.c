@@ -0,0 +1,833 @@
+#include "mlp.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+/* The minimum number of multiply-add operations for executing matrix multiplication with multiple threads. */
+#define PARALLEL_GEMM_MIN_OPS 65536.0
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int trans_a;
+  int trans_b;
+  int accumulate;
+  long m;
+  long n;
+  long k;
+  const double* a;
+  const double* b;
+  double* c;
+} dgemm_args_t;
+
+/**
+ * @!visibility private
+ * Calculate the rows [begin, end) of C = op(A) * op(B) (+ C).
+ * The matrices are stored in row-major order, op(A) is an m x k matrix, and op(B) is a k x n matrix.
+ */
+static void dgemm_rows(void* args_, const long begin, const long end) {
+  const dgemm_args_t* args = (dgemm_args_t*)args_;
+  const long m = args->m;
+  const long n = args->n;
+  const long k = args->k;
+  const double* a = args->a;
+  const double* b = args->b;
+  long i, j, p;
+  double* c_row;
+  double a_el;
+  double sum;
+
+  for (i = begin; i < end; i++) {
+    c_row = args->c + i * n;
+    if (!args->accumulate) {
+      memset(c_row, 0, n * sizeof(double));
+    }
+    if (!args->trans_b) {
+      for (p = 0; p < k; p++) {
+        a_el = args->trans_a ? a[p * m + i] : a[i * k + p];
+        if (a_el == 0.0) {
+          continue;
+        }
+        for (j = 0; j < n; j++) {
+          c_row[j] += a_el * b[p * n + j];
+        }
+      }
+    } else {
+      for (j = 0; j < n; j++) {
+        sum = 0.0;
+        for (p = 0; p < k; p++) {
+          sum += (args->trans_a ? a[p * m + i] : a[i * k + p]) * b[j * k + p];
+        }
+        c_row[j] += sum;
+      }
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ * Perform the matrix multiplication with rows of the output matrix distributed over threads.
+ */
+static void dgemm(const int trans_a, const int trans_b, const long m, const long n, const long k, const double* a,
+                  const double* b, double* c, const int accumulate, const int n_threads) {
+  dgemm_args_t args = {trans_a, trans_b, accumulate, m, n, k, a, b, c};
+  const int n_workers = (double)m * n * k < PARALLEL_GEMM_MIN_OPS ? 1 : n_threads;
+  parallel_for(m, n_workers, dgemm_rows, &args);
+}
+
+/**
+ * @!visibility private
+ * Return the shape of the array after checking that it is an array with the given number of dimensions.
+ */
+static size_t* checked_shape(VALUE arr, const int ndim, const char* name) {
+  if (rb_obj_is_kind_of(arr, numo_cNArray) != Qtrue || RNARRAY_NDIM(arr) != ndim) {
+    rb_raise(rb_eArgError, "Expect %s to be a %d-dimensional array", name, ndim);
+  }
+  return RNARRAY_SHAPE(arr);
+}
+
+/**
+ * @!visibility private
+ * Return whether the shapes with the given number of dimensions are the same.
+ */
+static int same_shape(const size_t* shape_a, const size_t* shape_b, const int ndim) {
+  int i;
+  for (i = 0; i < ndim; i++) {
+    if (shape_a[i] != shape_b[i]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int relu;
+  int has_mask;
+  int n_threads;
+  double dropout_rate;
+  uint64_t* rng_state;
+} affine_forward_opts;
+/**
+ * @!visibility private
+ */
+static void iter_fused_affine_forward(na_loop_t const* lp) {
+  const affine_forward_opts* opts = (affine_forward_opts*)lp->opt_ptr;
+  const double* x = (double*)NDL_PTR(lp, 0);
+  const double* weight = (double*)NDL_PTR(lp, 1);
+  const double* bias = (double*)NDL_PTR(lp, 2);
+  double* out = (double*)NDL_PTR(lp, 3);
+  double* mask = opts->has_mask ? (double*)NDL_PTR(lp, 4) : NULL;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_inputs = NDL_SHAPE(lp, 0)[1];
+  const long n_outputs = NDL_SHAPE(lp, 1)[1];
+  const long n_elements = n_samples * n_outputs;
+  const double rate = opts->dropout_rate;
+  const double scale = rate < 1.0 ? 1.0 / (1.0 - rate) : 0.0;
+  long i;
+
+  /* out = x * weight + bias */
+  for (i = 0; i < n_samples; i++) {
+    memcpy(out + i * n_outputs, bias, n_outputs * sizeof(double));
+  }
+  dgemm(0, 0, n_samples, n_outputs, n_inputs, x, weight, out, 1, opts->n_threads);
+
+  /* rectified linear function */
+  if (opts->relu) {
+    for (i = 0; i < n_elements; i++) {
+      if (!(out[i] > 0.0)) {
+        out[i] = 0.0;
+      }
+    }
+  }
+
+  /* dropout */
+  if (mask != NULL) {
+    for (i = 0; i < n_elements; i++) {
+      mask[i] = xoshiro256ss_uniform(opts->rng_state) >= rate ? scale : 0.0;
+      out[i] *= mask[i];
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Calculate affine transform followed by rectified linear function and dropout in place.
+ *
+ * @overload fused_affine_forward(x, weight, bias, out, mask, relu, dropout_rate, rng_state, n_threads) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_inputs]) The input values.
+ * @param weight [Numo::DFloat] (shape: [n_inputs, n_outputs]) The weight matrix.
+ * @param bias [Numo::DFloat] (shape: [n_outputs]) The bias vector.
+ * @param out [Numo::DFloat] (shape: [n_samples, n_outputs]) The buffer to store the output values.
+ * @param mask [Numo::DFloat/Nil] (shape: [n_samples, n_outputs]) The buffer to store the dropout mask.
+ *   If nil is given, dropout is not performed.
+ * @param relu [Boolean] The flag indicating whether to apply rectified linear function.
+ * @param dropout_rate [Float] The rate of the units to drop.
+ * @param rng_state [Numo::UInt64] (shape: [4]) The state of random generator for dropout.
+ * @param n_threads [Integer] The number of threads for matrix multiplication.
+ * @return [Nil]
+ */
+static VALUE fused_affine_forward(VALUE self, VALUE x, VALUE weight, VALUE bias, VALUE out, VALUE mask, VALUE relu,
+                                  VALUE dropout_rate, VALUE rng_state, VALUE n_threads) {
+  ndfunc_arg_in_t ain[5] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 1}, {numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  const int has_mask = !NIL_P(mask);
+  ndfunc_t ndf = {(na_iter_func_t)iter_fused_affine_forward, NO_LOOP, has_mask ? 5 : 4, 0, ain, 0};
+  affine_forward_opts opts = {RTEST(relu), has_mask, NUM2INT(n_threads), NUM2DBL(dropout_rate), NULL};
+  const size_t* x_shape = checked_shape(x, 2, "x");
+  const size_t* weight_shape = checked_shape(weight, 2, "weight");
+  const size_t* out_shape = checked_shape(out, 2, "out");
+  const size_t* mask_shape;
+
+  /* The kernel runs without ndloop iteration, so the shapes are not checked by Numo. */
+  if (x_shape[1] != weight_shape[0]) {
+    rb_raise(rb_eArgError, "Expect x to have %ld columns, but it has %ld columns", (long)weight_shape[0], (long)x_shape[1]);
+  }
+  if (checked_shape(bias, 1, "bias")[0] != weight_shape[1]) {
+    rb_raise(rb_eArgError, "Expect bias to have the same size as the number of columns of weight");
+  }
+  if (out_shape[0] != x_shape[0] || out_shape[1] != weight_shape[1]) {
+    rb_raise(rb_eArgError, "Expect out to have the shape [%ld, %ld]", (long)x_shape[0], (long)weight_shape[1]);
+  }
+  if (has_mask) {
+    mask_shape = checked_shape(mask, 2, "mask");
+    if (mask_shape[0] != out_shape[0] || mask_shape[1] != out_shape[1]) {
+      rb_raise(rb_eArgError, "Expect mask to have the same shape as out");
+    }
+  }
+
+  if (has_mask) {
+    opts.rng_state = (uint64_t*)na_get_pointer_for_read_write(rng_state);
+    na_ndloop3(&ndf, &opts, 5, x, weight, bias, out, mask);
+  } else {
+    na_ndloop3(&ndf, &opts, 4, x, weight, bias, out);
+  }
+
+  RB_GC_GUARD(x);
+  RB_GC_GUARD(out);
+  RB_GC_GUARD(mask);
+  RB_GC_GUARD(rng_state);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int relu;
+  int has_mask;
+  int has_dx;
+  int n_threads;
+} affine_backward_opts;
+/**
+ * @!visibility private
+ */
+static void iter_fused_affine_backward(na_loop_t const* lp) {
+  const affine_backward_opts* opts = (affine_backward_opts*)lp->opt_ptr;
+  const double* x = (double*)NDL_PTR(lp, 0);
+  const double* out = (double*)NDL_PTR(lp, 1);
+  double* dout = (double*)NDL_PTR(lp, 2);
+  const double* weight = (double*)NDL_PTR(lp, 3);
+  double* grad_weight = (double*)NDL_PTR(lp, 4);
+  double* grad_bias = (double*)NDL_PTR(lp, 5);
+  const double* mask = opts->has_mask ? (double*)NDL_PTR(lp, 6) : NULL;
+  double* dx = opts->has_dx ? (double*)NDL_PTR(lp, opts->has_mask ? 7 : 6) : NULL;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_inputs = NDL_SHAPE(lp, 0)[1];
+  const long n_outputs = NDL_SHAPE(lp, 3)[1];
+  long i, j;
+
+  /* Propagate the gradient through dropout and rectified linear function. */
+  for (i = 0; i < n_samples * n_outputs; i++) {
+    if (mask != NULL) {
+      dout[i] *= mask[i];
+    }
+    if (opts->relu && !(out[i] > 0.0)) {
+      dout[i] = 0.0;
+    }
+  }
+
+  /* gradient of bias */
+  memset(grad_bias, 0, n_outputs * sizeof(double));
+  for (i = 0; i < n_samples; i++) {
+    for (j = 0; j < n_outputs; j++) {
+      grad_bias[j] += dout[i * n_outputs + j];
+    }
+  }
+
+  /* gradient of weight: x^T * dout */
+  dgemm(1, 0, n_inputs, n_outputs, n_samples, x, dout, grad_weight, 0, opts->n_threads);
+
+  /* gradient of input: dout * weight^T */
+  if (dx != NULL) {
+    dgemm(0, 1, n_samples, n_inputs, n_outputs, dout, weight, dx, 0, opts->n_threads);
+  }
+}
+/**
+ * @!visibility private
+ * Calculate the gradients of fused affine layer in place.
+ *
+ * @overload fused_affine_backward(x, out, dout, weight, grad_weight, grad_bias, mask, dx, relu, n_threads) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_inputs]) The input values given to the forward pass.
+ * @param out [Numo::DFloat] (shape: [n_samples, n_outputs]) The output values of the forward pass.
+ * @param dout [Numo::DFloat] (shape: [n_samples, n_outputs]) The gradient of output values. It is overwritten.
+ * @param weight [Numo::DFloat] (shape: [n_inputs, n_outputs]) The weight matrix.
+ * @param grad_weight [Numo::DFloat] (shape: [n_inputs, n_outputs]) The buffer to store the gradient of weight.
+ * @param grad_bias [Numo::DFloat] (shape: [n_outputs]) The buffer to store the gradient of bias.
+ * @param mask [Numo::DFloat/Nil] (shape: [n_samples, n_outputs]) The dropout mask used in the forward pass.
+ * @param dx [Numo::DFloat/Nil] (shape: [n_samples, n_inputs]) The buffer to store the gradient of input values.
+ *   If nil is given, the gradient of input values is not calculated.
+ * @param relu [Boolean] The flag indicating whether rectified linear function is applied in the forward pass.
+ * @param n_threads [Integer] The number of threads for matrix multiplication.
+ * @return [Nil]
+ */
+static VALUE fused_affine_backward(VALUE self, VALUE x, VALUE out, VALUE dout, VALUE weight, VALUE grad_weight, VALUE grad_bias,
+                                   VALUE mask, VALUE dx, VALUE relu, VALUE n_threads) {
+  ndfunc_arg_in_t ain[8] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 2},
+                            {numo_cDFloat, 2}, {numo_cDFloat, 1}, {numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  const int has_mask = !NIL_P(mask);
+  const int has_dx = !NIL_P(dx);
+  ndfunc_t ndf = {(na_iter_func_t)iter_fused_affine_backward, NO_LOOP, 6 + has_mask + has_dx, 0, ain, 0};
+  affine_backward_opts opts = {RTEST(relu), has_mask, has_dx, NUM2INT(n_threads)};
+  const size_t* x_shape = checked_shape(x, 2, "x");
+  const size_t* weight_shape = checked_shape(weight, 2, "weight");
+  const size_t* out_shape;
+  const size_t* dx_shape;
+
+  /* The kernel runs without ndloop iteration, so the shapes are not checked by Numo. */
+  if (x_shape[1] != weight_shape[0]) {
+    rb_raise(rb_eArgError, "Expect x to have %ld columns, but it has %ld columns", (long)weight_shape[0], (long)x_shape[1]);
+  }
+  out_shape = checked_shape(out, 2, "out");
+  if (out_shape[0] != x_shape[0] || out_shape[1] != weight_shape[1]) {
+    rb_raise(rb_eArgError, "Expect out to have the shape [%ld, %ld]", (long)x_shape[0], (long)weight_shape[1]);
+  }
+  if (!same_shape(checked_shape(dout, 2, "dout"), out_shape, 2)) {
+    rb_raise(rb_eArgError, "Expect dout to have the same shape as out");
+  }
+  if (!same_shape(checked_shape(grad_weight, 2, "grad_weight"), weight_shape, 2)) {
+    rb_raise(rb_eArgError, "Expect grad_weight to have the same shape as weight");
+  }
+  if (checked_shape(grad_bias, 1, "grad_bias")[0] != weight_shape[1]) {
+    rb_raise(rb_eArgError, "Expect grad_bias to have the same size as the number of columns of weight");
+  }
+  if (has_mask && !same_shape(checked_shape(mask, 2, "mask"), out_shape, 2)) {
+    rb_raise(rb_eArgError, "Expect mask to have the same shape as out");
+  }
+  if (has_dx) {
+    dx_shape = checked_shape(dx, 2, "dx");
+    if (!same_shape(dx_shape, x_shape, 2)) {
+      rb_raise(rb_eArgError, "Expect dx to have the same shape as x");
+    }
+  }
+
+  if (has_mask && has_dx) {
+    na_ndloop3(&ndf, &opts, 8, x, out, dout, weight, grad_weight, grad_bias, mask, dx);
+  } else if (has_mask) {
+    na_ndloop3(&ndf, &opts, 7, x, out, dout, weight, grad_weight, grad_bias, mask);
+  } else if (has_dx) {
+    na_ndloop3(&ndf, &opts, 7, x, out, dout, weight, grad_weight, grad_bias, dx);
+  } else {
+    na_ndloop3(&ndf, &opts, 6, x, out, dout, weight, grad_weight, grad_bias);
+  }
+
+  RB_GC_GUARD(x);
+  RB_GC_GUARD(dout);
+  RB_GC_GUARD(mask);
+  RB_GC_GUARD(dx);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  double learning_rate;
+  double decay1;
+  double decay2;
+  double bias_correction1;
+  double bias_correction2;
+} adam_opts;
+/**
+ * @!visibility private
+ */
+static void iter_adam_update(na_loop_t const* lp) {
+  const adam_opts* opts = (adam_opts*)lp->opt_ptr;
+  size_t i, n;
+  char *p1, *p2, *p3, *p4;
+  ssize_t s1, s2, s3, s4;
+  double* w;
+  double g;
+  double* m;
+  double* v;
+
+  INIT_COUNTER(lp, n);
+  INIT_PTR(lp, 0, p1, s1);
+  INIT_PTR(lp, 1, p2, s2);
+  INIT_PTR(lp, 2, p3, s3);
+  INIT_PTR(lp, 3, p4, s4);
+
+  for (i = 0; i < n; i++) {
+    w = (double*)p1;
+    g = *(double*)p2;
+    m = (double*)p3;
+    v = (double*)p4;
+    *m = opts->decay1 * *m + (1.0 - opts->decay1) * g;
+    *v = opts->decay2 * *v + (1.0 - opts->decay2) * g * g;
+    *w -= opts->learning_rate * (*m / opts->bias_correction1) / (sqrt(*v / opts->bias_correction2) + 1e-8);
+    p1 += s1;
+    p2 += s2;
+    p3 += s3;
+    p4 += s4;
+  }
+}
+/**
+ * @!visibility private
+ * Update the weight and moments with Adam in place.
+ *
+ * @overload adam_update(weight, gradient, fst_moment, sec_moment, learning_rate, decay1, decay2, iter) -> nil
+ *
+ * @param weight [Numo::DFloat] The weight to be updated.
+ * @param gradient [Numo::DFloat] The gradient for updating the weight.
+ * @param fst_moment [Numo::DFloat] The first moment to be updated.
+ * @param sec_moment [Numo::DFloat] The second moment to be updated.
+ * @param learning_rate [Float] The learning rate.
+ * @param decay1 [Float] The smoothing parameter for the first moment.
+ * @param decay2 [Float] The smoothing parameter for the second moment.
+ * @param iter [Integer] The number of updates including the current one.
+ * @return [Nil]
+ */
+static VALUE adam_update(VALUE self, VALUE weight, VALUE gradient, VALUE fst_moment, VALUE sec_moment, VALUE learning_rate,
+                         VALUE decay1, VALUE decay2, VALUE iter) {
+  ndfunc_arg_in_t ain[4] = {{numo_cDFloat, 0}, {numo_cDFloat, 0}, {numo_cDFloat, 0}, {numo_cDFloat, 0}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_adam_update, FULL_LOOP, 4, 0, ain, 0};
+  const double d1 = NUM2DBL(decay1);
+  const double d2 = NUM2DBL(decay2);
+  const double t = NUM2DBL(iter);
+  adam_opts opts = {NUM2DBL(learning_rate), d1, d2, 1.0 - pow(d1, t), 1.0 - pow(d2, t)};
+  na_ndloop3(&ndf, &opts, 4, weight, gradient, fst_moment, sec_moment);
+  RB_GC_GUARD(weight);
+  RB_GC_GUARD(fst_moment);
+  RB_GC_GUARD(sec_moment);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_softmax_cross_entropy(na_loop_t const* lp) {
+  const double* out = (double*)NDL_PTR(lp, 0);
+  const double* y = (double*)NDL_PTR(lp, 1);
+  double* dout = (double*)NDL_PTR(lp, 2);
+  double* loss = (double*)lp->opt_ptr;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_outputs = NDL_SHAPE(lp, 0)[1];
+  long i, j;
+  double clip;
+  double sum_exp;
+  double sum_loss = 0.0;
+  const double* o;
+  const double* t;
+  double* d;
+
+  for (i = 0; i < n_samples; i++) {
+    o = out + i * n_outputs;
+    t = y + i * n_outputs;
+    d = dout + i * n_outputs;
+    clip = o[0];
+    for (j = 1; j < n_outputs; j++) {
+      if (o[j] > clip) {
+        clip = o[j];
+      }
+    }
+    sum_exp = 0.0;
+    for (j = 0; j < n_outputs; j++) {
+      d[j] = exp(o[j] - clip);
+      sum_exp += d[j];
+    }
+    for (j = 0; j < n_outputs; j++) {
+      d[j] /= sum_exp;
+      sum_loss -= t[j] * log(d[j] + 1e-8);
+      d[j] = (d[j] - t[j]) / n_samples;
+    }
+  }
+
+  *loss = sum_loss / n_samples;
+}
+/**
+ * @!visibility private
+ * Calculate softmax cross-entropy and its gradient.
+ *
+ * @overload softmax_cross_entropy(out, y, dout) -> Float
+ *
+ * @param out [Numo::DFloat] (shape: [n_samples, n_outputs]) The output values of network.
+ * @param y [Numo::DFloat] (shape: [n_samples, n_outputs]) The one-hot vectors of labels.
+ * @param dout [Numo::DFloat] (shape: [n_samples, n_outputs]) The buffer to store the gradient of output values.
+ * @return [Float] The loss value.
+ */
+static VALUE softmax_cross_entropy(VALUE self, VALUE out, VALUE y, VALUE dout) {
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_softmax_cross_entropy, NO_LOOP, 3, 0, ain, 0};
+  double loss = 0.0;
+  na_ndloop3(&ndf, &loss, 3, out, y, dout);
+  RB_GC_GUARD(dout);
+  return DBL2NUM(loss);
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_mean_squared_error(na_loop_t const* lp) {
+  const double* out = (double*)NDL_PTR(lp, 0);
+  const double* y = (double*)NDL_PTR(lp, 1);
+  double* dout = (double*)NDL_PTR(lp, 2);
+  double* loss = (double*)lp->opt_ptr;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_elements = n_samples * NDL_SHAPE(lp, 0)[1];
+  long i;
+  double diff;
+  double sum_loss = 0.0;
+
+  for (i = 0; i < n_elements; i++) {
+    diff = out[i] - y[i];
+    sum_loss += diff * diff;
+    dout[i] = 2.0 * diff / n_samples;
+  }
+
+  *loss = sum_loss / n_samples;
+}
+/**
+ * @!visibility private
+ * Calculate mean squared error and its gradient.
+ *
+ * @overload mean_squared_error(out, y, dout) -> Float
+ *
+ * @param out [Numo::DFloat] (shape: [n_samples, n_outputs]) The output values of network.
+ * @param y [Numo::DFloat] (shape: [n_samples, n_outputs]) The target values.
+ * @param dout [Numo::DFloat] (shape: [n_samples, n_outputs]) The buffer to store the gradient of output values.
+ * @return [Float] The loss value.
+ */
+static VALUE mean_squared_error(VALUE self, VALUE out, VALUE y, VALUE dout) {
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_mean_squared_error, NO_LOOP, 3, 0, ain, 0};
+  double loss = 0.0;
+  na_ndloop3(&ndf, &loss, 3, out, y, dout);
+  RB_GC_GUARD(dout);
+  return DBL2NUM(loss);
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_gather_rows(na_loop_t const* lp) {
+  const double* x = (double*)NDL_PTR(lp, 0);
+  const int32_t* ids = (int32_t*)NDL_PTR(lp, 1);
+  double* buf = (double*)NDL_PTR(lp, 2);
+  const long offset = *(long*)lp->opt_ptr;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_cols = NDL_SHAPE(lp, 0)[1];
+  const long n_rows = NDL_SHAPE(lp, 2)[0];
+  long i;
+
+  /* The indices are checked before copying, since ndloop releases its buffers even if an exception is raised. */
+  for (i = 0; i < n_rows; i++) {
+    if (ids[offset + i] < 0 || ids[offset + i] >= n_samples) {
+      rb_raise(rb_eArgError, "Expect the row indices to be in the range [0, %ld), but %d is given", n_samples, ids[offset + i]);
+    }
+  }
+
+  for (i = 0; i < n_rows; i++) {
+    memcpy(buf + i * n_cols, x + (long)ids[offset + i] * n_cols, n_cols * sizeof(double));
+  }
+}
+/**
+ * @!visibility private
+ * Copy the rows specified by the indices to the buffer.
+ *
+ * @overload gather_rows(x, ids, offset, buf) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_cols]) The source matrix.
+ * @param ids [Numo::Int32] (shape: [n_samples]) The row indices.
+ * @param offset [Integer] The position in the row indices from which to start copying.
+ * @param buf [Numo::DFloat] (shape: [n_rows, n_cols]) The buffer to store the copied rows.
+ * @return [Nil]
+ */
+static VALUE gather_rows(VALUE self, VALUE x, VALUE ids, VALUE offset, VALUE buf) {
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 2}, {numo_cInt32, 1}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_gather_rows, NO_LOOP, 3, 0, ain, 0};
+  long offset_ = NUM2LONG(offset);
+  const size_t* x_shape = checked_shape(x, 2, "x");
+  const size_t* buf_shape = checked_shape(buf, 2, "buf");
+  const long n_ids = (long)checked_shape(ids, 1, "ids")[0];
+
+  /* The kernel runs without ndloop iteration, so the shapes are not checked by Numo. */
+  if (buf_shape[1] != x_shape[1]) {
+    rb_raise(rb_eArgError, "Expect buf to have %ld columns, but it has %ld columns", (long)x_shape[1], (long)buf_shape[1]);
+  }
+  if (offset_ < 0 || offset_ + (long)buf_shape[0] > n_ids) {
+    rb_raise(rb_eArgError, "Expect the rows [%ld, %ld) to be in the range of the row indices of size %ld", offset_,
+             offset_ + (long)buf_shape[0], n_ids);
+  }
+
+  na_ndloop3(&ndf, &offset_, 3, x, ids, buf);
+  RB_GC_GUARD(buf);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_shuffle_ids(na_loop_t const* lp) {
+  int32_t* ids = (int32_t*)NDL_PTR(lp, 0);
+  uint64_t* rng_state = (uint64_t*)lp->opt_ptr;
+  const long n_elements = NDL_SHAPE(lp, 0)[0];
+  long i, j;
+  int32_t tmp;
+
+  for (i = n_elements - 1; i > 0; i--) {
+    j = (long)(xoshiro256ss_uniform(rng_state) * (i + 1));
+    tmp = ids[i];
+    ids[i] = ids[j];
+    ids[j] = tmp;
+  }
+}
+/**
+ * @!visibility private
+ * Shuffle the indices in place with Fisher-Yates algorithm.
+ *
+ * @overload shuffle_ids(ids, rng_state) -> nil
+ *
+ * @param ids [Numo::Int32] (shape: [n_elements]) The indices to be shuffled.
+ * @param rng_state [Numo::UInt64] (shape: [4]) The state of random generator.
+ * @return [Nil]
+ */
+static VALUE shuffle_ids(VALUE self, VALUE ids, VALUE rng_state) {
+  ndfunc_arg_in_t ain[1] = {{numo_cInt32, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_shuffle_ids, NO_LOOP, 1, 0, ain, 0};
+  uint64_t* state = (uint64_t*)na_get_pointer_for_read_write(rng_state);
+  na_ndloop3(&ndf, state, 1, ids);
+  RB_GC_GUARD(ids);
+  RB_GC_GUARD(rng_state);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  const double* x;
+  const float* weights;
+  const float* biases;
+  const int32_t* layer_sizes;
+  double* out;
+  long n_layers;
+  long max_units;
+  int alloc_failed;
+} compiled_forward_args_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int n_threads;
+  int invalid_shape;
+  int alloc_failed;
+} compiled_forward_opts;
+
+/**
+ * @!visibility private
+ * Calculate the forward pass of all layers for the samples [begin, end) with single-precision arithmetic.
+ * The scratch buffers are allocated without the GVL, so the failure is reported through the arguments.
+ */
+static void compiled_forward_rows(void* args_, const long begin, const long end) {
+  compiled_forward_args_t* args = (compiled_forward_args_t*)args_;
+  const long n_inputs = args->layer_sizes[0];
+  const long n_outputs = args->layer_sizes[args->n_layers];
+  float* curr = (float*)malloc(args->max_units * sizeof(float));
+  float* next = (float*)malloc(args->max_units * sizeof(float));
+  float* tmp;
+  const float* w;
+  const float* b;
+  long i, j, l, p, n_in, n_out;
+  float el;
+
+  if (curr == NULL || next == NULL) {
+    args->alloc_failed = 1;
+    free(curr);
+    free(next);
+    return;
+  }
+
+  for (i = begin; i < end; i++) {
+    for (j = 0; j < n_inputs; j++) {
+      curr[j] = (float)args->x[i * n_inputs + j];
+    }
+    w = args->weights;
+    b = args->biases;
+    for (l = 0; l < args->n_layers; l++) {
+      n_in = args->layer_sizes[l];
+      n_out = args->layer_sizes[l + 1];
+      memcpy(next, b, n_out * sizeof(float));
+      for (p = 0; p < n_in; p++) {
+        el = curr[p];
+        if (el == 0.0f) {
+          continue;
+        }
+        for (j = 0; j < n_out; j++) {
+          next[j] += el * w[p * n_out + j];
+        }
+      }
+      /* All layers except the output layer are followed by rectified linear function. */
+      if (l < args->n_layers - 1) {
+        for (j = 0; j < n_out; j++) {
+          if (!(next[j] > 0.0f)) {
+            next[j] = 0.0f;
+          }
+        }
+      }
+      w += n_in * n_out;
+      b += n_out;
+      tmp = curr;
+      curr = next;
+      next = tmp;
+    }
+    for (j = 0; j < n_outputs; j++) {
+      args->out[i * n_outputs + j] = (double)curr[j];
+    }
+  }
+
+  free(curr);
+  free(next);
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_compiled_forward(na_loop_t const* lp) {
+  compiled_forward_opts* opts = (compiled_forward_opts*)lp->opt_ptr;
+  compiled_forward_args_t args;
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  double n_ops = 0.0;
+  long n_biases = 0;
+  long l;
+
+  args.x = (double*)NDL_PTR(lp, 0);
+  args.weights = (float*)NDL_PTR(lp, 1);
+  args.biases = (float*)NDL_PTR(lp, 2);
+  args.layer_sizes = (int32_t*)NDL_PTR(lp, 3);
+  args.out = (double*)NDL_PTR(lp, 4);
+  args.n_layers = NDL_SHAPE(lp, 3)[0] - 1;
+  args.max_units = 0;
+  args.alloc_failed = 0;
+  for (l = 0; l <= args.n_layers; l++) {
+    if (args.layer_sizes[l] > args.max_units) {
+      args.max_units = args.layer_sizes[l];
+    }
+    if (l > 0) {
+      n_ops += (double)args.layer_sizes[l - 1] * args.layer_sizes[l];
+      n_biases += args.layer_sizes[l];
+    }
+  }
+
+  /* The kernel runs without ndloop iteration, so the shapes are checked here against the layer sizes. */
+  if (args.n_layers < 1 || (long)NDL_SHAPE(lp, 0)[1] != args.layer_sizes[0] || (double)NDL_SHAPE(lp, 1)[0] != n_ops ||
+      (long)NDL_SHAPE(lp, 2)[0] != n_biases || (long)NDL_SHAPE(lp, 4)[0] != n_samples ||
+      (long)NDL_SHAPE(lp, 4)[1] != args.layer_sizes[args.n_layers]) {
+    opts->invalid_shape = 1;
+    return;
+  }
+
+  parallel_for(n_samples, n_samples * n_ops < PARALLEL_GEMM_MIN_OPS ? 1 : opts->n_threads, compiled_forward_rows, &args);
+  opts->alloc_failed = args.alloc_failed;
+}
+/**
+ * @!visibility private
+ * Calculate the forward pass of compiled network.
+ *
+ * @overload compiled_forward(x, weights, biases, layer_sizes, out, n_threads) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_inputs]) The input values.
+ * @param weights [Numo::SFloat] (shape: [n_weights]) The concatenated weight matrices of all layers in row-major order.
+ * @param biases [Numo::SFloat] (shape: [n_biases]) The concatenated bias vectors of all layers.
+ * @param layer_sizes [Numo::Int32] (shape: [n_layers + 1]) The number of inputs and the number of units in each layer.
+ * @param out [Numo::DFloat] (shape: [n_samples, n_outputs]) The buffer to store the output values.
+ * @param n_threads [Integer] The number of threads.
+ * @return [Nil]
+ */
+static VALUE compiled_forward(VALUE self, VALUE x, VALUE weights, VALUE biases, VALUE layer_sizes, VALUE out, VALUE n_threads) {
+  ndfunc_arg_in_t ain[5] = {{numo_cDFloat, 2}, {numo_cSFloat, 1}, {numo_cSFloat, 1}, {numo_cInt32, 1}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_compiled_forward, NO_LOOP, 5, 0, ain, 0};
+  compiled_forward_opts opts = {NUM2INT(n_threads), 0, 0};
+  na_ndloop3(&ndf, &opts, 5, x, weights, biases, layer_sizes, out);
+  RB_GC_GUARD(x);
+  RB_GC_GUARD(out);
+  if (opts.invalid_shape) {
+    rb_raise(rb_eArgError,
+             "Expect x to have as many columns as the inputs of the network, and out to have as many as the outputs");
+  }
+  if (opts.alloc_failed) {
+    rb_raise(rb_eNoMemError, "Failed to allocate the buffers for the forward pass");
+  }
+  return Qnil;
+}
+
+void init_mlp_module() {
+  VALUE mNeuralNetwork = rb_define_module_under(mRumale, "NeuralNetwork");
+  VALUE mLayer = rb_define_module_under(mNeuralNetwork, "Layer");
+  VALUE mOptimizer = rb_define_module_under(mNeuralNetwork, "Optimizer");
+  VALUE mLoss = rb_define_module_under(mNeuralNetwork, "Loss");
+  VALUE mModel = rb_define_module_under(mNeuralNetwork, "Model");
+  /**
+   * Document-module: Rumale::NeuralNetwork::ExtBaseMLP
+   * @!visibility private
+   * The mixin module consisting of extension method for BaseMLP class.
+   * This module is used internally.
+   */
+  VALUE mExtBaseMLP = rb_define_module_under(mNeuralNetwork, "ExtBaseMLP");
+  /**
+   * Document-module: Rumale::NeuralNetwork::Layer::ExtFusedAffine
+   * @!visibility private
+   * The mixin module consisting of extension method for FusedAffine class.
+   * This module is used internally.
+   */
+  VALUE mExtFusedAffine = rb_define_module_under(mLayer, "ExtFusedAffine");
+  /**
+   * Document-module: Rumale::NeuralNetwork::Optimizer::ExtAdam
+   * @!visibility private
+   * The mixin module consisting of extension method for Adam class.
+   * This module is used internally.
+   */
+  VALUE mExtAdam = rb_define_module_under(mOptimizer, "ExtAdam");
+  /**
+   * Document-module: Rumale::NeuralNetwork::Loss::ExtSoftmaxCrossEntropy
+   * @!visibility private
+   * The mixin module consisting of extension method for SoftmaxCrossEntropy class.
+   * This module is used internally.
+   */
+  VALUE mExtSoftmaxCrossEntropy = rb_define_module_under(mLoss, "ExtSoftmaxCrossEntropy");
+  /**
+   * Document-module: Rumale::NeuralNetwork::Loss::ExtMeanSquaredError
+   * @!visibility private
+   * The mixin module consisting of extension method for MeanSquaredError class.
+   * This module is used internally.
+   */
+  VALUE mExtMeanSquaredError = rb_define_module_under(mLoss, "ExtMeanSquaredError");
+  /**
+   * Document-module: Rumale::NeuralNetwork::Model::ExtCompiledNetwork
+   * @!visibility private
+   * The mixin module consisting of extension method for CompiledNetwork class.
+   * This module is used internally.
+   */
+  VALUE mExtCompiledNetwork = rb_define_module_under(mModel, "ExtCompiledNetwork");
+
+  rb_define_private_method(mExtBaseMLP, "gather_rows", gather_rows, 4);
+  rb_define_private_method(mExtBaseMLP, "shuffle_ids", shuffle_ids, 2);
+  rb_define_private_method(mExtFusedAffine, "fused_affine_forward", fused_affine_forward, 9);
+  rb_define_private_method(mExtFusedAffine, "fused_affine_backward", fused_affine_backward, 10);
+  rb_define_private_method(mExtAdam, "adam_update", adam_update, 8);
+  rb_define_private_method(mExtSoftmaxCrossEntropy, "softmax_cross_entropy", softmax_cross_entropy, 3);
+  rb_define_private_method(mExtMeanSquaredError, "mean_squared_error", mean_squared_error, 3);
+  rb_define_private_method(mExtCompiledNetwork, "compiled_forward", compiled_forward, 6);
+}
@@ -0,0 +1,18 @@
+#ifndef RUMALE_MLP_H
+#define RUMALE_MLP_H 1
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ruby.h>
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+#include "parallel.h"
+#include "random.h"
+
+void init_mlp_module();
+
+#endif /* RUMALE_MLP_H */
@@ -0,0 +1,109 @@
+#include "parallel.h"
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  parallel_func_t func;
+  void* arg;
+  long begin;
+  long end;
+} parallel_chunk_t;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  parallel_func_t func;
+  void* arg;
+  long n_items;
+  int n_threads;
+} parallel_ctx_t;
+
+static void* run_chunk(void* chunk_) {
+  parallel_chunk_t* chunk = (parallel_chunk_t*)chunk_;
+  chunk->func(chunk->arg, chunk->begin, chunk->end);
+  return NULL;
+}
+
+static void* run_parallel_without_gvl(void* ctx_) {
+  parallel_ctx_t* ctx = (parallel_ctx_t*)ctx_;
+  const int n_threads = ctx->n_threads;
+  const long n_items = ctx->n_items;
+  const long sz_chunk = (n_items + n_threads - 1) / n_threads;
+  parallel_chunk_t* chunks = (parallel_chunk_t*)malloc(n_threads * sizeof(parallel_chunk_t));
+#ifdef HAVE_PTHREAD_H
+  pthread_t* threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+  int* launched = (int*)calloc(n_threads, sizeof(int));
+#endif
+  int alloc_failed = chunks == NULL;
+  int t;
+
+#ifdef HAVE_PTHREAD_H
+  alloc_failed = alloc_failed || threads == NULL || launched == NULL;
+  if (alloc_failed) {
+    free(threads);
+    free(launched);
+  }
+#endif
+  /* The whole range is processed on the calling thread if the memory for the threads can not be allocated. */
+  if (alloc_failed) {
+    free(chunks);
+    ctx->func(ctx->arg, 0, n_items);
+    return NULL;
+  }
+
+  for (t = 0; t < n_threads; t++) {
+    chunks[t].func = ctx->func;
+    chunks[t].arg = ctx->arg;
+    chunks[t].begin = t * sz_chunk < n_items ? t * sz_chunk : n_items;
+    chunks[t].end = (t + 1) * sz_chunk < n_items ? (t + 1) * sz_chunk : n_items;
+  }
+
+#ifdef HAVE_PTHREAD_H
+  /* The first chunk is processed on the calling thread. */
+  for (t = 1; t < n_threads; t++) {
+    launched[t] = pthread_create(&threads[t], NULL, run_chunk, &chunks[t]) == 0;
+  }
+  run_chunk(&chunks[0]);
+  for (t = 1; t < n_threads; t++) {
+    if (launched[t]) {
+      pthread_join(threads[t], NULL);
+    } else {
+      run_chunk(&chunks[t]);
+    }
+  }
+  free(threads);
+  free(launched);
+#else
+  for (t = 0; t < n_threads; t++) {
+    run_chunk(&chunks[t]);
+  }
+#endif
+
+  free(chunks);
+  return NULL;
+}
+
+/**
+ * @!visibility private
+ * Split the range [0, n_items) into n_threads contiguous chunks and process them concurrently.
+ * The worker function must not touch any Ruby object because it runs without the GVL.
+ */
+void parallel_for(const long n_items, const int n_threads, parallel_func_t func, void* arg) {
+  parallel_ctx_t ctx;
+
+  if (n_items <= 0) {
+    return;
+  }
+  if (n_threads <= 1 || n_items == 1) {
+    func(arg, 0, n_items);
+    return;
+  }
+
+  ctx.func = func;
+  ctx.arg = arg;
+  ctx.n_items = n_items;
+  ctx.n_threads = n_threads < n_items ? n_threads : (int)n_items;
+  rb_thread_call_without_gvl(run_parallel_without_gvl, &ctx, NULL, NULL);
+}
@@ -0,0 +1,15 @@
+#ifndef RUMALE_PARALLEL_H
+#define RUMALE_PARALLEL_H 1
+
+#include <ruby.h>
+#include <ruby/thread.h>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+typedef void (*parallel_func_t)(void* arg, const long begin, const long end);
+
+void parallel_for(const long n_items, const int n_threads, parallel_func_t func, void* arg);
+
+#endif /* RUMALE_PARALLEL_H */
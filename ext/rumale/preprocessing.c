@@ -0,0 +1,689 @@
+#include "preprocessing.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int degree;
+  int interaction_only;
+  long n_features;
+  /* The column index of the first monomial of each degree. */
+  int64_t offsets[64];
+  /* The table of the number of monomials preceding each feature, (degree) x (n_features + 1). */
+  int64_t* n_preceding;
+  /* The output buffers: either of dense row or pair of sparse indices and values. */
+  double* dense_out;
+  int32_t* sparse_indices;
+  double* sparse_values;
+  long n_outputs;
+} poly_args_t;
+
+/**
+ * @!visibility private
+ * Calculate the number of combinations of r elements out of m elements.
+ */
+static int64_t n_combinations(const int64_t m, const int r) {
+  int64_t res = 1;
+  int i;
+  if (r < 0 || m < r) {
+    return 0;
+  }
+  for (i = 0; i < r; i++) {
+    res = res * (m - i) / (i + 1);
+  }
+  return res;
+}
+
+/**
+ * @!visibility private
+ * Calculate the number of monomials of degree r consisting of n features.
+ */
+static int64_t n_monomials(const int64_t n, const int r, const int interaction_only) {
+  return interaction_only ? n_combinations(n, r) : n_combinations(n + r - 1, r);
+}
+
+/**
+ * @!visibility private
+ * Prepare the column offsets and the table for ranking monomials in lexicographic order of feature indices.
+ * n_preceding[r][v] is the number of monomials whose remaining r factors follow a factor with index smaller than v.
+ */
+static void poly_args_init(poly_args_t* args, const long n_features, const int degree, const int interaction_only) {
+  int r, t;
+  long v;
+  int64_t* table;
+
+  args->degree = degree;
+  args->interaction_only = interaction_only;
+  args->n_features = n_features;
+  args->offsets[0] = 0;
+  args->offsets[1] = 1;
+  for (t = 1; t < degree; t++) {
+    args->offsets[t + 1] = args->offsets[t] + n_monomials(n_features, t, interaction_only);
+  }
+
+  args->n_preceding = ALLOC_N(int64_t, degree * (n_features + 1));
+  for (r = 0; r < degree; r++) {
+    table = args->n_preceding + r * (n_features + 1);
+    table[0] = 0;
+    for (v = 0; v < n_features; v++) {
+      table[v + 1] = table[v] + (interaction_only ? n_combinations(n_features - v - 1, r)
+                                                  : n_combinations(n_features - v + r - 1, r));
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ * Emit the monomials of degree t consisting of the non-zero features in lexicographic order of feature indices.
+ * The factor at position p is chosen from the non-zero features starting at start.
+ */
+static void poly_expand_rec(poly_args_t* args, const double* vals, const int32_t* cols, const long n_nonzeros, const int t,
+                            const int p, const long start, const double prod, const int64_t rank, const long prev_col) {
+  const int r = t - p - 1;
+  const int64_t* table = args->n_preceding + r * (args->n_features + 1);
+  const long lower = p == 0 ? 0 : (args->interaction_only ? prev_col + 1 : prev_col);
+  long q, col;
+  int64_t curr_rank;
+  double val;
+
+  for (q = start; q < n_nonzeros; q++) {
+    col = cols != NULL ? cols[q] : q;
+    curr_rank = rank + table[col] - table[lower];
+    val = prod * vals[q];
+    if (r > 0) {
+      poly_expand_rec(args, vals, cols, n_nonzeros, t, p + 1, args->interaction_only ? q + 1 : q, val, curr_rank, col);
+    } else if (args->dense_out != NULL) {
+      args->dense_out[args->offsets[t] + curr_rank] = val;
+    } else {
+      args->sparse_indices[args->n_outputs] = (int32_t)(args->offsets[t] + curr_rank);
+      args->sparse_values[args->n_outputs] = val;
+      args->n_outputs++;
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ * Expand the row consisting of the given non-zero features into the bias and the monomials of all degrees.
+ * If cols is NULL, vals is regarded as the dense row.
+ */
+static void poly_expand_row(poly_args_t* args, const double* vals, const int32_t* cols, const long n_nonzeros) {
+  int t;
+
+  if (args->dense_out != NULL) {
+    args->dense_out[0] = 1.0;
+  } else {
+    args->sparse_indices[args->n_outputs] = 0;
+    args->sparse_values[args->n_outputs] = 1.0;
+    args->n_outputs++;
+  }
+  for (t = 1; t <= args->degree; t++) {
+    poly_expand_rec(args, vals, cols, n_nonzeros, t, 0, 0, 1.0, 0, 0);
+  }
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  int degree;
+  int interaction_only;
+  long n_features;
+} poly_opts;
+/**
+ * @!visibility private
+ */
+static void iter_polynomial_expand(na_loop_t const* lp) {
+  const poly_opts* opts = (poly_opts*)lp->opt_ptr;
+  const double* x = (double*)NDL_PTR(lp, 0);
+  double* z = (double*)NDL_PTR(lp, 1);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  const long n_outputs = NDL_SHAPE(lp, 1)[1];
+  poly_args_t args;
+  long i;
+
+  memset(&args, 0, sizeof(args));
+  poly_args_init(&args, n_features, opts->degree, opts->interaction_only);
+  for (i = 0; i < n_samples; i++) {
+    args.dense_out = z + i * n_outputs;
+    poly_expand_row(&args, x + i * n_features, NULL, n_features);
+  }
+  xfree(args.n_preceding);
+}
+/**
+ * @!visibility private
+ * Expand the samples to the polynomial features in place of the preallocated output.
+ *
+ * @overload polynomial_expand(x, z, degree, interaction_only) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be transformed.
+ * @param z [Numo::DFloat] (shape: [n_samples, n_output_features]) The buffer to store the polynomial features.
+ * @param degree [Integer] The degree of polynomial features.
+ * @param interaction_only [Boolean] The flag indicating whether to generate only the products of distinct features.
+ * @return [Nil]
+ */
+static VALUE polynomial_expand(VALUE self, VALUE x, VALUE z, VALUE degree, VALUE interaction_only) {
+  ndfunc_arg_in_t ain[2] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_polynomial_expand, NO_LOOP, 2, 0, ain, 0};
+  poly_opts opts = {NUM2INT(degree), RTEST(interaction_only), 0};
+  if (opts.degree < 1 || opts.degree > 63) {
+    rb_raise(rb_eArgError, "Expect the value of degree parameter to be between 1 and 63.");
+  }
+  na_ndloop3(&ndf, &opts, 2, x, z);
+  RB_GC_GUARD(z);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_polynomial_csr_indptr(na_loop_t const* lp) {
+  const poly_opts* opts = (poly_opts*)lp->opt_ptr;
+  const int64_t* indptr = (int64_t*)NDL_PTR(lp, 0);
+  int64_t* out_indptr = (int64_t*)NDL_PTR(lp, 1);
+  const long n_samples = NDL_SHAPE(lp, 0)[0] - 1;
+  long i;
+  int t;
+  int64_t n_nonzeros;
+
+  out_indptr[0] = 0;
+  for (i = 0; i < n_samples; i++) {
+    n_nonzeros = indptr[i + 1] - indptr[i];
+    out_indptr[i + 1] = out_indptr[i] + 1;
+    for (t = 1; t <= opts->degree; t++) {
+      out_indptr[i + 1] += n_monomials(n_nonzeros, t, opts->interaction_only);
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Calculate the row offsets of the polynomial features of sparse matrix in CSR format.
+ * The number of stored elements in each row depends only on the number of stored elements in the input row.
+ *
+ * @overload polynomial_csr_indptr(indptr, out_indptr, degree, interaction_only) -> nil
+ *
+ * @param indptr [Numo::Int64] (shape: [n_samples + 1]) The offsets of each row of the input matrix.
+ * @param out_indptr [Numo::Int64] (shape: [n_samples + 1]) The buffer to store the offsets of each row of the output matrix.
+ * @param degree [Integer] The degree of polynomial features.
+ * @param interaction_only [Boolean] The flag indicating whether to generate only the products of distinct features.
+ * @return [Nil]
+ */
+static VALUE polynomial_csr_indptr(VALUE self, VALUE indptr, VALUE out_indptr, VALUE degree, VALUE interaction_only) {
+  ndfunc_arg_in_t ain[2] = {{numo_cInt64, 1}, {numo_cInt64, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_polynomial_csr_indptr, NO_LOOP, 2, 0, ain, 0};
+  poly_opts opts = {NUM2INT(degree), RTEST(interaction_only), 0};
+  na_ndloop3(&ndf, &opts, 2, indptr, out_indptr);
+  RB_GC_GUARD(out_indptr);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_polynomial_csr_expand(na_loop_t const* lp) {
+  const poly_opts* opts = (poly_opts*)lp->opt_ptr;
+  const double* data = (double*)NDL_PTR(lp, 0);
+  const int32_t* indices = (int32_t*)NDL_PTR(lp, 1);
+  const int64_t* indptr = (int64_t*)NDL_PTR(lp, 2);
+  const long n_samples = NDL_SHAPE(lp, 2)[0] - 1;
+  poly_args_t args;
+  long i;
+
+  memset(&args, 0, sizeof(args));
+  poly_args_init(&args, opts->n_features, opts->degree, opts->interaction_only);
+  args.sparse_values = (double*)NDL_PTR(lp, 3);
+  args.sparse_indices = (int32_t*)NDL_PTR(lp, 4);
+  for (i = 0; i < n_samples; i++) {
+    poly_expand_row(&args, data + indptr[i], indices + indptr[i], (long)(indptr[i + 1] - indptr[i]));
+  }
+  xfree(args.n_preceding);
+}
+/**
+ * @!visibility private
+ * Expand the sparse matrix in CSR format to the polynomial features.
+ * The column indices in each row of the input matrix are assumed to be sorted in ascending order.
+ *
+ * @overload polynomial_csr_expand(data, indices, indptr, out_data, out_indices, n_features, degree, interaction_only) -> nil
+ *
+ * @param data [Numo::DFloat] (shape: [nnz]) The non-zero elements of the input matrix.
+ * @param indices [Numo::Int32] (shape: [nnz]) The column indices of non-zero elements of the input matrix.
+ * @param indptr [Numo::Int64] (shape: [n_samples + 1]) The offsets of each row of the input matrix.
+ * @param out_data [Numo::DFloat] (shape: [out_nnz]) The buffer to store the elements of the output matrix.
+ * @param out_indices [Numo::Int32] (shape: [out_nnz]) The buffer to store the column indices of the output matrix.
+ * @param n_features [Integer] The number of features of the input matrix.
+ * @param degree [Integer] The degree of polynomial features.
+ * @param interaction_only [Boolean] The flag indicating whether to generate only the products of distinct features.
+ * @return [Nil]
+ */
+static VALUE polynomial_csr_expand(VALUE self, VALUE data, VALUE indices, VALUE indptr, VALUE out_data, VALUE out_indices,
+                                   VALUE n_features, VALUE degree, VALUE interaction_only) {
+  ndfunc_arg_in_t ain[5] = {{numo_cDFloat, 1}, {numo_cInt32, 1}, {numo_cInt64, 1}, {numo_cDFloat, 1}, {numo_cInt32, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_polynomial_csr_expand, NO_LOOP, 5, 0, ain, 0};
+  poly_opts opts = {NUM2INT(degree), RTEST(interaction_only), NUM2LONG(n_features)};
+  if (opts.degree < 1 || opts.degree > 63) {
+    rb_raise(rb_eArgError, "Expect the value of degree parameter to be between 1 and 63.");
+  }
+  na_ndloop3(&ndf, &opts, 5, data, indices, indptr, out_data, out_indices);
+  RB_GC_GUARD(out_data);
+  RB_GC_GUARD(out_indices);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_one_hot_count(na_loop_t const* lp) {
+  const int32_t* x = (int32_t*)NDL_PTR(lp, 0);
+  const int32_t* feature_indices = (int32_t*)NDL_PTR(lp, 1);
+  int32_t* counts = (int32_t*)NDL_PTR(lp, 2);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  long i, j;
+
+  for (i = 0; i < n_samples; i++) {
+    for (j = 0; j < n_features; j++) {
+      if (x[i * n_features + j] < feature_indices[j + 1] - feature_indices[j]) {
+        counts[feature_indices[j] + x[i * n_features + j]]++;
+      }
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Count the occurrences of each categorical value.
+ *
+ * @overload one_hot_count(x, feature_indices, counts) -> nil
+ *
+ * @param x [Numo::Int32] (shape: [n_samples, n_features]) The non-negative categorical values.
+ * @param feature_indices [Numo::Int32] (shape: [n_features + 1]) The indices to feature ranges.
+ * @param counts [Numo::Int32] (shape: [feature_indices[-1]]) The zero-filled buffer to store the counts.
+ * @return [Nil]
+ */
+static VALUE one_hot_count(VALUE self, VALUE x, VALUE feature_indices, VALUE counts) {
+  ndfunc_arg_in_t ain[3] = {{numo_cInt32, 2}, {numo_cInt32, 1}, {numo_cInt32, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_one_hot_count, NO_LOOP, 3, 0, ain, 0};
+  na_ndloop(&ndf, 3, x, feature_indices, counts);
+  RB_GC_GUARD(counts);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ * Return the output column of the categorical value of the feature, or -1 if the value is unknown or inactive.
+ */
+static inline int32_t one_hot_column(const int32_t val, const long feature_id, const int32_t* feature_indices,
+                                     const int32_t* active_map) {
+  if (val < 0 || val >= feature_indices[feature_id + 1] - feature_indices[feature_id]) {
+    return -1;
+  }
+  return active_map[feature_indices[feature_id] + val];
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_one_hot_encode_csr(na_loop_t const* lp) {
+  const int32_t* x = (int32_t*)NDL_PTR(lp, 0);
+  const int32_t* feature_indices = (int32_t*)NDL_PTR(lp, 1);
+  const int32_t* active_map = (int32_t*)NDL_PTR(lp, 2);
+  int32_t* indices = (int32_t*)NDL_PTR(lp, 3);
+  int64_t* indptr = (int64_t*)NDL_PTR(lp, 4);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  int64_t nnz = 0;
+  int32_t col;
+  long i, j;
+
+  indptr[0] = 0;
+  for (i = 0; i < n_samples; i++) {
+    for (j = 0; j < n_features; j++) {
+      col = one_hot_column(x[i * n_features + j], j, feature_indices, active_map);
+      if (col >= 0) {
+        indices[nnz++] = col;
+      }
+    }
+    indptr[i + 1] = nnz;
+  }
+}
+/**
+ * @!visibility private
+ * Encode the categorical values to the column indices of one-hot-vectors in CSR format.
+ * Since the ranges of features do not overlap, the column indices in each row are sorted in ascending order.
+ *
+ * @overload one_hot_encode_csr(x, feature_indices, active_map, indices, indptr) -> nil
+ *
+ * @param x [Numo::Int32] (shape: [n_samples, n_features]) The categorical values.
+ * @param feature_indices [Numo::Int32] (shape: [n_features + 1]) The indices to feature ranges.
+ * @param active_map [Numo::Int32] (shape: [feature_indices[-1]]) The output column for each categorical value (-1 if inactive).
+ * @param indices [Numo::Int32] (shape: [n_samples * n_features]) The buffer to store the column indices.
+ * @param indptr [Numo::Int64] (shape: [n_samples + 1]) The buffer to store the offsets of each row.
+ * @return [Nil]
+ */
+static VALUE one_hot_encode_csr(VALUE self, VALUE x, VALUE feature_indices, VALUE active_map, VALUE indices, VALUE indptr) {
+  ndfunc_arg_in_t ain[5] = {{numo_cInt32, 2}, {numo_cInt32, 1}, {numo_cInt32, 1}, {numo_cInt32, 1}, {numo_cInt64, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_one_hot_encode_csr, NO_LOOP, 5, 0, ain, 0};
+  na_ndloop(&ndf, 5, x, feature_indices, active_map, indices, indptr);
+  RB_GC_GUARD(indices);
+  RB_GC_GUARD(indptr);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+static void iter_one_hot_encode_dense(na_loop_t const* lp) {
+  const int integer_codes = *(int*)lp->opt_ptr;
+  const int32_t* x = (int32_t*)NDL_PTR(lp, 0);
+  const int32_t* feature_indices = (int32_t*)NDL_PTR(lp, 1);
+  const int32_t* active_map = (int32_t*)NDL_PTR(lp, 2);
+  char* codes = NDL_PTR(lp, 3);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  const long n_codes = NDL_SHAPE(lp, 3)[1];
+  int32_t col;
+  long i, j;
+
+  for (i = 0; i < n_samples; i++) {
+    for (j = 0; j < n_features; j++) {
+      col = one_hot_column(x[i * n_features + j], j, feature_indices, active_map);
+      if (col < 0) {
+        continue;
+      }
+      if (integer_codes) {
+        ((int32_t*)codes)[i * n_codes + col] = 1;
+      } else {
+        ((double*)codes)[i * n_codes + col] = 1.0;
+      }
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Encode the categorical values to one-hot-vectors in place of the zero-filled dense matrix.
+ *
+ * @overload one_hot_encode_dense(x, feature_indices, active_map, codes) -> nil
+ *
+ * @param x [Numo::Int32] (shape: [n_samples, n_features]) The categorical values.
+ * @param feature_indices [Numo::Int32] (shape: [n_features + 1]) The indices to feature ranges.
+ * @param active_map [Numo::Int32] (shape: [feature_indices[-1]]) The output column for each categorical value (-1 if inactive).
+ * @param codes [Numo::DFloat/Numo::Int32] (shape: [n_samples, n_active_features])
+ *   The zero-filled buffer to store one-hot-vectors.
+ * @return [Nil]
+ */
+static VALUE one_hot_encode_dense(VALUE self, VALUE x, VALUE feature_indices, VALUE active_map, VALUE codes) {
+  int integer_codes = rb_obj_is_kind_of(codes, numo_cInt32) == Qtrue;
+  ndfunc_arg_in_t ain[4] = {
+      {numo_cInt32, 2}, {numo_cInt32, 1}, {numo_cInt32, 1}, {integer_codes ? numo_cInt32 : numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_one_hot_encode_dense, NO_LOOP, 4, 0, ain, 0};
+  na_ndloop3(&ndf, &integer_codes, 4, x, feature_indices, active_map, codes);
+  RB_GC_GUARD(codes);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef enum { BIN_DFLOAT, BIN_UINT8, BIN_UINT16, BIN_INT32 } bin_type_t;
+/**
+ * @!visibility private
+ */
+static void iter_discretize(na_loop_t const* lp) {
+  const bin_type_t out_type = *(bin_type_t*)lp->opt_ptr;
+  const double* x = (double*)NDL_PTR(lp, 0);
+  const double* steps = (double*)NDL_PTR(lp, 1);
+  char* out = NDL_PTR(lp, 2);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  const long n_bins = NDL_SHAPE(lp, 1)[1];
+  const double* feature_steps;
+  long i, j, lo, hi, mid, bin, pos;
+  double val;
+
+  for (i = 0; i < n_samples; i++) {
+    for (j = 0; j < n_features; j++) {
+      pos = i * n_features + j;
+      val = x[pos];
+      feature_steps = steps + j * n_bins;
+      /* Find the number of steps less than or equal to the value, i.e. the upper bound. */
+      lo = 0;
+      hi = n_bins;
+      while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (val >= feature_steps[mid]) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      bin = lo > 0 ? lo - 1 : 0;
+      switch (out_type) {
+      case BIN_UINT8:
+        ((uint8_t*)out)[pos] = (uint8_t)bin;
+        break;
+      case BIN_UINT16:
+        ((uint16_t*)out)[pos] = (uint16_t)bin;
+        break;
+      case BIN_INT32:
+        ((int32_t*)out)[pos] = (int32_t)bin;
+        break;
+      default:
+        ((double*)out)[pos] = (double)bin;
+        break;
+      }
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Discretize the feature values to the indices of bins with binary search over the feature steps.
+ * The index of bin is the largest one whose step is less than or equal to the value, and zero if there is no such step.
+ *
+ * @overload discretize(x, steps, out) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be discretized.
+ * @param steps [Numo::DFloat] (shape: [n_features, n_bins]) The ascending feature steps of each feature.
+ * @param out [Numo::DFloat/Numo::UInt8/Numo::UInt16/Numo::Int32] (shape: [n_samples, n_features])
+ *   The buffer to store the indices of bins.
+ * @return [Nil]
+ */
+static VALUE discretize(VALUE self, VALUE x, VALUE steps, VALUE out) {
+  bin_type_t out_type = BIN_DFLOAT;
+  VALUE out_class = numo_cDFloat;
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 2}, {numo_cDFloat, 2}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_discretize, NO_LOOP, 3, 0, ain, 0};
+
+  if (rb_obj_is_kind_of(out, numo_cUInt8) == Qtrue) {
+    out_type = BIN_UINT8;
+    out_class = numo_cUInt8;
+  } else if (rb_obj_is_kind_of(out, numo_cUInt16) == Qtrue) {
+    out_type = BIN_UINT16;
+    out_class = numo_cUInt16;
+  } else if (rb_obj_is_kind_of(out, numo_cInt32) == Qtrue) {
+    out_type = BIN_INT32;
+    out_class = numo_cInt32;
+  }
+  ain[2].type = out_class;
+
+  na_ndloop3(&ndf, &out_type, 3, x, steps, out);
+  RB_GC_GUARD(out);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  double mul;
+  double add;
+} scale_opts_t;
+/**
+ * @!visibility private
+ */
+static void iter_scale_features(na_loop_t const* lp) {
+  const scale_opts_t* opts = (scale_opts_t*)lp->opt_ptr;
+  double* x = (double*)NDL_PTR(lp, 0);
+  const double* shift = (double*)NDL_PTR(lp, 1);
+  const double* scale = (double*)NDL_PTR(lp, 2);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  const double mul = opts->mul;
+  const double add = opts->add;
+  double* row;
+  long i, j;
+
+  for (i = 0; i < n_samples; i++) {
+    row = x + i * n_features;
+    for (j = 0; j < n_features; j++) {
+      row[j] = (row[j] - shift[j]) / scale[j] * mul + add;
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Scale each feature of the samples in place, i.e. x[i, j] = (x[i, j] - shift[j]) / scale[j] * mul + add.
+ *
+ * @overload scale_features(x, shift, scale, mul, add) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the scaled values.
+ * @param shift [Numo::DFloat] (shape: [n_features]) The values subtracted from each feature.
+ * @param scale [Numo::DFloat] (shape: [n_features]) The values dividing each shifted feature.
+ * @param mul [Float] The value multiplied to all the scaled features.
+ * @param add [Float] The value added to all the scaled features.
+ * @return [Nil]
+ */
+static VALUE scale_features(VALUE self, VALUE x, VALUE shift, VALUE scale, VALUE mul, VALUE add) {
+  ndfunc_arg_in_t ain[3] = {{numo_cDFloat, 2}, {numo_cDFloat, 1}, {numo_cDFloat, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_scale_features, NO_LOOP, 3, 0, ain, 0};
+  scale_opts_t opts = {NUM2DBL(mul), NUM2DBL(add)};
+
+  na_ndloop3(&ndf, &opts, 3, x, shift, scale);
+  RB_GC_GUARD(x);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ */
+typedef enum { NORM_L1, NORM_L2, NORM_MAX } norm_type_t;
+/**
+ * @!visibility private
+ */
+static void iter_normalize_samples(na_loop_t const* lp) {
+  const norm_type_t norm_type = *(norm_type_t*)lp->opt_ptr;
+  double* x = (double*)NDL_PTR(lp, 0);
+  double* norm_vec = (double*)NDL_PTR(lp, 1);
+  const long n_samples = NDL_SHAPE(lp, 0)[0];
+  const long n_features = NDL_SHAPE(lp, 0)[1];
+  double* row;
+  double norm, val;
+  long i, j;
+
+  for (i = 0; i < n_samples; i++) {
+    row = x + i * n_features;
+    norm = 0.0;
+    for (j = 0; j < n_features; j++) {
+      val = fabs(row[j]);
+      switch (norm_type) {
+      case NORM_L1:
+        norm += val;
+        break;
+      case NORM_L2:
+        norm += val * val;
+        break;
+      default:
+        if (val > norm) norm = val;
+        break;
+      }
+    }
+    if (norm_type == NORM_L2) norm = sqrt(norm);
+    if (norm == 0.0) norm = 1.0;
+    norm_vec[i] = norm;
+    for (j = 0; j < n_features; j++) {
+      row[j] /= norm;
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Normalize each sample in place with its norm. The samples with zero norm are left as they are.
+ *
+ * @overload normalize_samples(x, norm_vec, norm) -> nil
+ *
+ * @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the normalized values.
+ * @param norm_vec [Numo::DFloat] (shape: [n_samples]) The buffer to store the norm of each sample.
+ * @param norm [Symbol] The type of norm (:l1, :l2, or :max).
+ * @return [Nil]
+ */
+static VALUE normalize_samples(VALUE self, VALUE x, VALUE norm_vec, VALUE norm) {
+  ndfunc_arg_in_t ain[2] = {{numo_cDFloat, 2}, {numo_cDFloat, 1}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_normalize_samples, NO_LOOP, 2, 0, ain, 0};
+  norm_type_t norm_type;
+  const ID norm_id = rb_to_id(norm);
+
+  if (norm_id == rb_intern("l1")) {
+    norm_type = NORM_L1;
+  } else if (norm_id == rb_intern("l2")) {
+    norm_type = NORM_L2;
+  } else if (norm_id == rb_intern("max")) {
+    norm_type = NORM_MAX;
+  } else {
+    rb_raise(rb_eArgError, "Expect norm to be :l1, :l2, or :max");
+  }
+
+  na_ndloop3(&ndf, &norm_type, 2, x, norm_vec);
+  RB_GC_GUARD(x);
+  RB_GC_GUARD(norm_vec);
+  return Qnil;
+}
+
+void init_preprocessing_module() {
+  VALUE mPreprocessing = rb_define_module_under(mRumale, "Preprocessing");
+  /**
+   * Document-module: Rumale::Preprocessing::ExtPolynomialFeatures
+   * @!visibility private
+   * The mixin module consisting of extension methods for PolynomialFeatures class.
+   * This module is used internally.
+   */
+  VALUE mExtPolynomialFeatures = rb_define_module_under(mPreprocessing, "ExtPolynomialFeatures");
+  /**
+   * Document-module: Rumale::Preprocessing::ExtOneHotEncoder
+   * @!visibility private
+   * The mixin module consisting of extension methods for OneHotEncoder class.
+   * This module is used internally.
+   */
+  VALUE mExtOneHotEncoder = rb_define_module_under(mPreprocessing, "ExtOneHotEncoder");
+  /**
+   * Document-module: Rumale::Preprocessing::ExtBinDiscretizer
+   * @!visibility private
+   * The mixin module consisting of extension method for BinDiscretizer class.
+   * This module is used internally.
+   */
+  VALUE mExtBinDiscretizer = rb_define_module_under(mPreprocessing, "ExtBinDiscretizer");
+  /**
+   * Document-module: Rumale::Preprocessing::ExtScaler
+   * @!visibility private
+   * The mixin module consisting of extension method for StandardScaler, MinMaxScaler, and MaxAbsScaler classes.
+   * This module is used internally.
+   */
+  VALUE mExtScaler = rb_define_module_under(mPreprocessing, "ExtScaler");
+  /**
+   * Document-module: Rumale::Preprocessing::ExtNormalizer
+   * @!visibility private
+   * The mixin module consisting of extension method for L1Normalizer, L2Normalizer, and MaxNormalizer classes.
+   * This module is used internally.
+   */
+  VALUE mExtNormalizer = rb_define_module_under(mPreprocessing, "ExtNormalizer");
+
+  rb_define_private_method(mExtPolynomialFeatures, "polynomial_expand", polynomial_expand, 4);
+  rb_define_private_method(mExtPolynomialFeatures, "polynomial_csr_indptr", polynomial_csr_indptr, 4);
+  rb_define_private_method(mExtPolynomialFeatures, "polynomial_csr_expand", polynomial_csr_expand, 8);
+  rb_define_private_method(mExtOneHotEncoder, "one_hot_count", one_hot_count, 3);
+  rb_define_private_method(mExtOneHotEncoder, "one_hot_encode_csr", one_hot_encode_csr, 5);
+  rb_define_private_method(mExtOneHotEncoder, "one_hot_encode_dense", one_hot_encode_dense, 4);
+  rb_define_private_method(mExtBinDiscretizer, "discretize", discretize, 3);
+  rb_define_private_method(mExtScaler, "scale_features", scale_features, 5);
+  rb_define_private_method(mExtNormalizer, "normalize_samples", normalize_samples, 3);
+}
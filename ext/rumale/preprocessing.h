@@ -0,0 +1,15 @@
+#ifndef RUMALE_PREPROCESSING_H
+#define RUMALE_PREPROCESSING_H 1
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ruby.h>
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+void init_preprocessing_module();
+
+#endif /* RUMALE_PREPROCESSING_H */
@@ -0,0 +1,129 @@
+#include "random.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+/* The number of random numbers drawn from each stream. It must be even for the pairs of Box-Muller transform. */
+#define RANDOM_BLOCK_SIZE 4096
+/* The minimum number of blocks for filling the buffer with multiple threads. */
+#define RANDOM_PARALLEL_MIN_BLOCKS 16
+
+/**
+ * @!visibility private
+ */
+typedef struct {
+  double* out;
+  long n_elements;
+  const uint64_t* seed;
+  int normal;
+  double mu;
+  double sigma;
+} random_fill_args_t;
+
+/**
+ * @!visibility private
+ * Fill the blocks [begin, end) of the buffer with random numbers. Each block is drawn from its own stream.
+ */
+static void fill_random_blocks(void* args_, const long begin, const long end) {
+  const random_fill_args_t* args = (random_fill_args_t*)args_;
+  uint64_t state[4];
+  double* out;
+  double r, theta;
+  long b, i, n;
+
+  for (b = begin; b < end; b++) {
+    xoshiro256ss_stream(state, args->seed, (uint64_t)b);
+    out = args->out + b * RANDOM_BLOCK_SIZE;
+    n = args->n_elements - b * RANDOM_BLOCK_SIZE;
+    if (n > RANDOM_BLOCK_SIZE) n = RANDOM_BLOCK_SIZE;
+    if (!args->normal) {
+      for (i = 0; i < n; i++) out[i] = xoshiro256ss_uniform(state);
+      continue;
+    }
+    /* Box-Muller transform yields two independent normal random numbers from a pair of uniform random numbers. */
+    for (i = 0; i < n; i += 2) {
+      r = args->sigma * sqrt(-2.0 * log(1.0 - xoshiro256ss_uniform(state)));
+      theta = 2.0 * M_PI * xoshiro256ss_uniform(state);
+      out[i] = args->mu + r * cos(theta);
+      if (i + 1 < n) out[i + 1] = args->mu + r * sin(theta);
+    }
+  }
+}
+
+/**
+ * @!visibility private
+ */
+static void fill_random(VALUE out, VALUE seed, const int normal, const double mu, const double sigma, VALUE n_threads) {
+  random_fill_args_t args;
+  long n_blocks;
+  int n_threads_;
+
+  args.out = (double*)na_get_pointer_for_write(out);
+  args.n_elements = (long)RNARRAY_SIZE(out);
+  args.seed = (const uint64_t*)na_get_pointer_for_read(seed);
+  args.normal = normal;
+  args.mu = mu;
+  args.sigma = sigma;
+  n_blocks = (args.n_elements + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE;
+  n_threads_ = NUM2INT(n_threads);
+  if (n_threads_ > n_blocks) n_threads_ = (int)n_blocks;
+  if (n_threads_ < 1) n_threads_ = 1;
+
+  if (n_threads_ > 1 && n_blocks >= RANDOM_PARALLEL_MIN_BLOCKS) {
+    parallel_for(n_blocks, n_threads_, fill_random_blocks, &args);
+  } else {
+    fill_random_blocks(&args, 0, n_blocks);
+  }
+  RB_GC_GUARD(out);
+  RB_GC_GUARD(seed);
+}
+
+/**
+ * @!visibility private
+ * Fill the array with random numbers from the uniform distribution over [0, 1) in place.
+ * The array is divided into blocks, and each block is drawn from the independent xoshiro256** stream
+ * derived from the seed and the block number, so that the result does not depend on the number of threads.
+ *
+ * @overload fill_uniform(out, seed, n_threads) -> nil
+ *
+ * @param out [Numo::DFloat] The contiguous array to be filled.
+ * @param seed [Numo::UInt64] (shape: [4]) The seed of random generator.
+ * @param n_threads [Integer] The number of threads to fill the blocks.
+ * @return [Nil]
+ */
+static VALUE fill_uniform(VALUE self, VALUE out, VALUE seed, VALUE n_threads) {
+  fill_random(out, seed, 0, 0.0, 1.0, n_threads);
+  return Qnil;
+}
+
+/**
+ * @!visibility private
+ * Fill the array with random numbers from the normal distribution in place with Box-Muller transform.
+ * The streams are derived in the same way as fill_uniform.
+ *
+ * @overload fill_normal(out, seed, mu, sigma, n_threads) -> nil
+ *
+ * @param out [Numo::DFloat] The contiguous array to be filled.
+ * @param seed [Numo::UInt64] (shape: [4]) The seed of random generator.
+ * @param mu [Float] The mean of normal distribution.
+ * @param sigma [Float] The standard deviation of normal distribution.
+ * @param n_threads [Integer] The number of threads to fill the blocks.
+ * @return [Nil]
+ */
+static VALUE fill_normal(VALUE self, VALUE out, VALUE seed, VALUE mu, VALUE sigma, VALUE n_threads) {
+  fill_random(out, seed, 1, NUM2DBL(mu), NUM2DBL(sigma), n_threads);
+  return Qnil;
+}
+
+void init_random_module() {
+  VALUE mUtils = rb_define_module_under(mRumale, "Utils");
+  /**
+   * Document-module: Rumale::Utils::ExtRandom
+   * @!visibility private
+   * The mixin module consisting of extension methods for generating random numbers.
+   * This module is used internally.
+   */
+  VALUE mExtRandom = rb_define_module_under(mUtils, "ExtRandom");
+
+  rb_define_private_method(mExtRandom, "fill_uniform", fill_uniform, 3);
+  rb_define_private_method(mExtRandom, "fill_normal", fill_normal, 5);
+}
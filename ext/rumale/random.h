@@ -0,0 +1,70 @@
+#ifndef RUMALE_RANDOM_H
+#define RUMALE_RANDOM_H 1
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ruby.h>
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+#include "parallel.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static inline uint64_t rotl64(const uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+/**
+ * @!visibility private
+ * Generate a random 64-bit integer with splitmix64 algorithm, which is used to initialize the state of xoshiro256**.
+ */
+static inline uint64_t splitmix64_next(uint64_t* x) {
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @!visibility private
+ * Generate a random 64-bit integer with xoshiro256** algorithm.
+ */
+static inline uint64_t xoshiro256ss_next(uint64_t* s) {
+  const uint64_t result = rotl64(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl64(s[3], 45);
+  return result;
+}
+
+/**
+ * @!visibility private
+ * Generate a random number from the uniform distribution over [0, 1).
+ */
+static inline double xoshiro256ss_uniform(uint64_t* s) { return (xoshiro256ss_next(s) >> 11) * (1.0 / 9007199254740992.0); }
+
+/**
+ * @!visibility private
+ * Initialize the state of the stream identified by the number from the seed state.
+ * The streams with different numbers are independent, so that each thread can draw random numbers from its own stream
+ * and the results do not depend on the number of threads.
+ */
+static inline void xoshiro256ss_stream(uint64_t* s, const uint64_t* seed, const uint64_t stream_id) {
+  uint64_t id = stream_id;
+  uint64_t x = seed[0] ^ rotl64(seed[1], 16) ^ rotl64(seed[2], 32) ^ rotl64(seed[3], 48) ^ splitmix64_next(&id);
+  int i;
+
+  for (i = 0; i < 4; i++) s[i] = splitmix64_next(&x);
+}
+
+void init_random_module();
+
+#endif /* RUMALE_RANDOM_H */
@@ -6,4 +6,10 @@ void Init_rumaleext(void) {
   mRumale = rb_define_module("Rumale");
 
   init_tree_module();
+  init_mlp_module();
+  init_sparse_module();
+  init_feature_extraction_module();
+  init_preprocessing_module();
+  init_dataset_module();
+  init_random_module();
 }
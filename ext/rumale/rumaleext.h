@@ -3,6 +3,12 @@
 
 #include <ruby.h>
 
+#include "dataset.h"
+#include "feature_extraction.h"
+#include "mlp.h"
+#include "preprocessing.h"
+#include "random.h"
+#include "sparse.h"
 #include "tree.h"
 
 #endif /* RUMALEEXT_H */
@@ -0,0 +1,54 @@
+#include "sparse.h"
+
+RUBY_EXTERN VALUE mRumale;
+
+/**
+ * @!visibility private
+ */
+static void iter_csr_to_dense(na_loop_t const* lp) {
+  const double* data = (double*)NDL_PTR(lp, 0);
+  const int32_t* indices = (int32_t*)NDL_PTR(lp, 1);
+  const int64_t* indptr = (int64_t*)NDL_PTR(lp, 2);
+  double* out = (double*)NDL_PTR(lp, 3);
+  const long n_rows = NDL_SHAPE(lp, 3)[0];
+  const long n_cols = NDL_SHAPE(lp, 3)[1];
+  long i;
+  int64_t j;
+
+  for (i = 0; i < n_rows; i++) {
+    for (j = indptr[i]; j < indptr[i + 1]; j++) {
+      out[i * n_cols + indices[j]] = data[j];
+    }
+  }
+}
+/**
+ * @!visibility private
+ * Scatter the elements of sparse matrix in compressed sparse row format into dense matrix.
+ *
+ * @overload csr_to_dense(data, indices, indptr, out) -> nil
+ *
+ * @param data [Numo::DFloat] (shape: [nnz]) The non-zero elements.
+ * @param indices [Numo::Int32] (shape: [nnz]) The column indices of non-zero elements.
+ * @param indptr [Numo::Int64] (shape: [n_rows + 1]) The offsets of each row in data and indices.
+ * @param out [Numo::DFloat] (shape: [n_rows, n_cols]) The zero-filled dense matrix to store the elements.
+ * @return [Nil]
+ */
+static VALUE csr_to_dense(VALUE self, VALUE data, VALUE indices, VALUE indptr, VALUE out) {
+  ndfunc_arg_in_t ain[4] = {{numo_cDFloat, 1}, {numo_cInt32, 1}, {numo_cInt64, 1}, {numo_cDFloat, 2}};
+  ndfunc_t ndf = {(na_iter_func_t)iter_csr_to_dense, NO_LOOP, 4, 0, ain, 0};
+  na_ndloop(&ndf, 4, data, indices, indptr, out);
+  RB_GC_GUARD(out);
+  return Qnil;
+}
+
+void init_sparse_module() {
+  /**
+   * Document-module: Rumale::ExtCSRMatrix
+   * @!visibility private
+   * The mixin module consisting of extension method for CSRMatrix class.
+   * This module is used internally.
+   */
+  VALUE mExtCSRMatrix = rb_define_module_under(mRumale, "ExtCSRMatrix");
+
+  rb_define_private_method(mExtCSRMatrix, "csr_to_dense", csr_to_dense, 4);
+}
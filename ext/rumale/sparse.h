@@ -0,0 +1,14 @@
+#ifndef RUMALE_SPARSE_H
+#define RUMALE_SPARSE_H 1
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ruby.h>
+
+#include <numo/narray.h>
+#include <numo/template.h>
+
+void init_sparse_module();
+
+#endif /* RUMALE_SPARSE_H */
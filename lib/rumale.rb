@@ -8,6 +8,7 @@ require 'rumale/version'
 require 'rumale/validation'
 require 'rumale/values'
 require 'rumale/utils'
+require 'rumale/csr_matrix'
 require 'rumale/pairwise_metric'
 require 'rumale/dataset'
 require 'rumale/probabilistic_output'
@@ -114,6 +115,9 @@ require 'rumale/model_selection/stratified_shuffle_split'
 require 'rumale/model_selection/time_series_split'
 require 'rumale/model_selection/cross_validation'
 require 'rumale/model_selection/grid_search_cv'
+require 'rumale/model_selection/halving_grid_search_cv'
+require 'rumale/model_selection/halving_random_search_cv'
+require 'rumale/model_selection/randomized_search_cv'
 require 'rumale/model_selection/function'
 require 'rumale/evaluation_measure/accuracy'
 require 'rumale/evaluation_measure/precision'
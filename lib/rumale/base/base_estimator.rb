@@ -1,5 +1,7 @@
 # frozen_string_literal: true
 
+require 'rumale/utils'
+
 module Rumale
   # This module consists of basic mix-in classes.
   module Base
@@ -26,19 +28,11 @@ module Rumale
       end
 
       def enable_parallel?
-        return false if @params[:n_jobs].nil?
-
-        if defined?(Parallel).nil?
-          warn('If you want to use parallel option, you should install and load Parallel in advance.')
-          return false
-        end
-        true
+        Rumale::Utils.enable_parallel?(@params[:n_jobs])
       end
 
       def n_processes
-        return 1 unless enable_parallel?
-
-        @params[:n_jobs] <= 0 ? Parallel.processor_count : @params[:n_jobs]
+        Rumale::Utils.n_processes(@params[:n_jobs])
       end
 
       def parallel_map(n_outputs, &block)
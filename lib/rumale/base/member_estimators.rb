@@ -0,0 +1,29 @@
+# frozen_string_literal: true
+
+module Rumale
+  module Base
+    # Module for the estimators that consist of the member estimators given as a hash, such as voting ensembles and feature union.
+    # The class including this module must include BaseEstimator to run the members in parallel with the n_jobs parameter.
+    module MemberEstimators
+      private
+
+      def fit_members(members, x, y)
+        if enable_parallel?
+          # the members are fitted in the worker processes, so the fitted copies are returned and stored into the hash.
+          names = members.keys
+          fitted = parallel_map(names.size) { |n| members[names[n]].fit(x, y) }
+          names.zip(fitted).each { |name, member| members[name] = member }
+        else
+          members.each_value { |member| member.fit(x, y) }
+        end
+        members
+      end
+
+      def each_member_output(members, method, x)
+        names = members.keys
+        outputs = enable_parallel? ? parallel_map(names.size) { |n| members[names[n]].public_send(method, x) } : nil
+        names.each_with_index { |name, n| yield name, outputs.nil? ? members[name].public_send(method, x) : outputs[n] }
+      end
+    end
+  end
+end
@@ -0,0 +1,111 @@
+# frozen_string_literal: true
+
+module Rumale
+  # CSRMatrix is a class that represents sparse matrix in compressed sparse row (CSR) format.
+  # The column indices of non-zero elements in row i are stored in indices[indptr[i]...indptr[i + 1]],
+  # and the corresponding values are stored in data[indptr[i]...indptr[i + 1]].
+  #
+  # @example
+  #   x = Rumale::CSRMatrix.from_dense(Numo::DFloat[[1, 0, 2], [0, 0, 3]])
+  #   # > pp x.data
+  #   # Numo::DFloat#shape=[3]
+  #   # [1, 2, 3]
+  #   # > pp x.indices
+  #   # Numo::Int32#shape=[3]
+  #   # [0, 2, 2]
+  #   # > pp x.indptr
+  #   # Numo::Int64#shape=[3]
+  #   # [0, 2, 3]
+  class CSRMatrix
+    include ExtCSRMatrix
+
+    # Return the values of non-zero elements.
+    # @return [Numo::DFloat] (shape: [nnz])
+    attr_reader :data
+
+    # Return the column indices of non-zero elements.
+    # @return [Numo::Int32] (shape: [nnz])
+    attr_reader :indices
+
+    # Return the offsets of each row in data and indices.
+    # @return [Numo::Int64] (shape: [n_rows + 1])
+    attr_reader :indptr
+
+    # Return the shape of matrix.
+    # @return [Array<Integer>] ([n_rows, n_cols])
+    attr_reader :shape
+
+    # Create a new sparse matrix in CSR format.
+    #
+    # @param data [Numo::DFloat] (shape: [nnz]) The values of non-zero elements.
+    # @param indices [Numo::Int32] (shape: [nnz]) The column indices of non-zero elements.
+    # @param indptr [Numo::Int64] (shape: [n_rows + 1]) The offsets of each row in data and indices.
+    # @param shape [Array<Integer>] The shape of matrix ([n_rows, n_cols]).
+    # @raise [ArgumentError] If the given arrays do not represent a valid matrix with the given shape.
+    def initialize(data, indices, indptr, shape)
+      @data = data.is_a?(Numo::DFloat) ? data : Numo::DFloat.cast(data)
+      @indices = indices.is_a?(Numo::Int32) ? indices : Numo::Int32.cast(indices)
+      @indptr = indptr.is_a?(Numo::Int64) ? indptr : Numo::Int64.cast(indptr)
+      @shape = shape.map(&:to_i)
+      check_structure
+    end
+
+    # Create a new sparse matrix from the dense matrix.
+    #
+    # @param x [Numo::DFloat] (shape: [n_rows, n_cols]) The dense matrix.
+    # @return [CSRMatrix]
+    def self.from_dense(x)
+      x = Numo::DFloat.cast(x) unless x.is_a?(Numo::DFloat)
+      raise ArgumentError, 'Expect dense matrix to be 2-D array' unless x.ndim == 2
+
+      n_rows, n_cols = x.shape
+      mask = x.ne(0.0)
+      positions = mask.where
+      indptr = Numo::Int64.zeros(n_rows + 1)
+      indptr[1..-1] = mask.count_true(axis: 1).cumsum if n_rows.positive?
+      data = positions.empty? ? Numo::DFloat.zeros(0) : x[positions]
+      new(data, positions % n_cols, indptr, [n_rows, n_cols])
+    end
+
+    # Return the number of non-zero elements.
+    # @return [Integer]
+    def nnz
+      @data.size
+    end
+
+    # Convert the sparse matrix to the dense matrix.
+    #
+    # @return [Numo::DFloat] (shape: [n_rows, n_cols]) The dense matrix.
+    def to_dense
+      z = Numo::DFloat.zeros(*@shape)
+      csr_to_dense(@data, @indices, @indptr, z) if nnz.positive?
+      z
+    end
+
+    # Check whether the given sparse matrix has the same shape and elements.
+    #
+    # @param other [CSRMatrix] The sparse matrix to be compared.
+    # @return [Boolean]
+    def ==(other)
+      other.is_a?(CSRMatrix) && @shape == other.shape && @data == other.data &&
+        @indices == other.indices && @indptr == other.indptr
+    end
+
+    private
+
+    # The native methods index the dense buffers with indptr and indices without checking the bounds,
+    # so the structure is validated once here with the vectorized operations.
+    def check_structure
+      raise ArgumentError, 'Expect shape to consist of two non-negative integers' unless @shape.size == 2 && @shape.min >= 0
+      raise ArgumentError, 'Expect data and indices to have the same size' unless @data.size == @indices.size
+      raise ArgumentError, 'Expect indptr to have the size of the number of rows plus one' unless @indptr.size == @shape[0] + 1
+      unless @indptr[0].zero? && @indptr[-1] == nnz
+        raise ArgumentError, 'Expect indptr to start at zero and end at the number of non-zero elements'
+      end
+      raise ArgumentError, 'Expect indptr to be non-decreasing' if @shape[0].positive? && (@indptr[1..-1] - @indptr[0...-1]).lt(0).any?
+      return if nnz.zero? || (@indices.min >= 0 && @indices.max < @shape[1])
+
+      raise ArgumentError, 'Expect indices to be in the range of the number of columns'
+    end
+  end
+end
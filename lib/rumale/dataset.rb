@@ -1,58 +1,150 @@
 # frozen_string_literal: true
 
-require 'csv'
+require 'rumale/rumaleext'
 require 'rumale/validation'
 require 'rumale/utils'
+require 'rumale/csr_matrix'
 require 'rumale/preprocessing/min_max_scaler'
+require 'rumale/dataset/batch_reader'
 
 module Rumale
   # Module for loading and saving a dataset file.
   module Dataset
+    extend ExtDataset
+    extend BatchReader
+
     class << self
       # Load a dataset with the libsvm file format into Numo::NArray.
+      # The file is parsed by the native extension, which maps the file into memory
+      # and parses line-aligned chunks of the file in parallel.
       #
       # @param filename [String] A path to a dataset file.
       # @param n_features [Integer/Nil] The number of features of data to load.
       #   If nil is given, it will be detected automatically from given file.
       # @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false).
       # @param dtype [Numo::NArray] Data type of Numo::NArray for features to be loaded.
+      #   If sparse is true, this parameter is ignored and the features are loaded as Numo::DFloat.
+      # @param sparse [Boolean] The flag indicating whether to load the features as a sparse matrix in CSR format.
+      # @param n_jobs [Integer] The number of threads for parsing the file.
+      #   If nil is given, the file is parsed on a single thread.
+      #   If zero or less is given, it uses all processors.
       #
       # @return [Array<Numo::NArray>]
-      #   Returns array containing the (n_samples x n_features) matrix for feature vectors
+      #   Returns array containing the (n_samples x n_features) matrix (or Rumale::CSRMatrix) for feature vectors
       #   and (n_samples) vector for labels or target values.
-      def load_libsvm_file(filename, n_features: nil, zero_based: false, dtype: Numo::DFloat)
-        ftvecs = []
-        labels = []
-        n_features_detected = 0
-        CSV.foreach(filename, col_sep: "\s", headers: false) do |line|
-          label, ftvec, max_idx = parse_libsvm_line(line, zero_based)
-          labels.push(label)
-          ftvecs.push(ftvec)
-          n_features_detected = max_idx if n_features_detected < max_idx
-        end
-        n_features ||= n_features_detected
-        n_features = [n_features, n_features_detected].max
-        [convert_to_matrix(ftvecs, n_features, dtype), Numo::NArray.asarray(labels)]
+      def load_libsvm_file(filename, n_features: nil, zero_based: false, dtype: Numo::DFloat, sparse: false, n_jobs: nil)
+        Rumale::Validation.check_params_numeric_or_nil(n_features: n_features, n_jobs: n_jobs)
+        Rumale::Validation.check_params_boolean(zero_based: zero_based, sparse: sparse)
+        parsed = parse_libsvm_file(filename.to_s, zero_based, n_threads(n_jobs))
+        n_features = [n_features || 0, parsed.last + 1].max
+        libsvm_dataset(parsed, n_features, dtype, sparse)
       end
 
       # Dump the dataset with the libsvm file format.
+      # The lines are formatted by the native extension, which writes floating point values
+      # with the shortest representation that can be read back to the same values.
       #
-      # @param data [Numo::NArray] (shape: [n_samples, n_features]) matrix consisting of feature vectors.
+      # @param data [Numo::NArray/Rumale::CSRMatrix] (shape: [n_samples, n_features]) matrix consisting of feature vectors.
       # @param labels [Numo::NArray] (shape: [n_samples]) matrix consisting of labels or target values.
       # @param filename [String] A path to the output libsvm file.
       # @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false).
       def dump_libsvm_file(data, labels, filename, zero_based: false)
+        Rumale::Validation.check_params_boolean(zero_based: zero_based)
         n_samples = [data.shape[0], labels.shape[0]].min
-        single_label = labels.shape[1].nil?
-        label_type = detect_dtype(labels)
-        value_type = detect_dtype(data)
-        File.open(filename, 'w') do |file|
-          n_samples.times do |n|
-            label = single_label ? labels[n] : labels[n, true].to_a
-            file.puts(dump_libsvm_line(label, data[n, true],
-                                       label_type, value_type, zero_based))
-          end
+        int_labels = integer_array?(labels)
+        labels = labels.expand_dims(1) if labels.ndim == 1
+        labels = contiguous_array(Numo::DFloat.cast(labels[0...n_samples, true]))
+        if data.is_a?(Rumale::CSRMatrix)
+          write_libsvm_file(filename.to_s, labels, contiguous_array(data.data), contiguous_array(data.indices),
+                            contiguous_array(data.indptr), int_labels, false, zero_based)
+        else
+          write_libsvm_file(filename.to_s, labels, contiguous_array(Numo::DFloat.cast(data)), nil, nil,
+                            int_labels, integer_array?(data), zero_based)
+        end
+        nil
+      end
+
+      # Save the dataset into the binary file that can be loaded quickly with the load_binary method.
+      # The arrays are stored with their types and shapes in a container aligned to 64 bytes.
+      #
+      # @example
+      #   x, y = Rumale::Dataset.load_libsvm_file('train.t', sparse: true)
+      #   Rumale::Dataset.save_binary('train.rbd', x, y)
+      #   x, y = Rumale::Dataset.load_binary('train.rbd')
+      #
+      # @param filename [String] A path to the output binary file.
+      # @param data [Numo::NArray/Rumale::CSRMatrix] (shape: [n_samples, n_features]) matrix consisting of feature vectors.
+      # @param labels [Numo::NArray/Nil] (shape: [n_samples]) matrix consisting of labels or target values.
+      def save_binary(filename, data, labels = nil)
+        arrays = {}
+        if data.is_a?(Rumale::CSRMatrix)
+          arrays['csr_data'] = data.data
+          arrays['csr_indices'] = data.indices
+          arrays['csr_indptr'] = data.indptr
+          arrays['csr_shape'] = Numo::Int64[*data.shape]
+        else
+          arrays['data'] = data
+        end
+        arrays['labels'] = labels unless labels.nil?
+        write_binary_arrays(filename.to_s, arrays.keys, arrays.values.map { |a| a.is_a?(Numo::NArray) ? contiguous_array(a) : a })
+        nil
+      end
+
+      # Load the dataset from the binary file saved with the save_binary method.
+      # The file is mapped into memory and the contents of each array are copied at once without parsing.
+      #
+      # @param filename [String] A path to the binary file.
+      # @return [Array<Numo::NArray>]
+      #   Returns array containing the (n_samples x n_features) matrix (or Rumale::CSRMatrix) for feature vectors
+      #   and (n_samples) vector for labels or target values (nil if not saved).
+      def load_binary(filename)
+        arrays = read_binary_arrays(filename.to_s)
+        data = if arrays.key?('csr_data')
+                 Rumale::CSRMatrix.new(arrays['csr_data'], arrays['csr_indices'], arrays['csr_indptr'], arrays['csr_shape'].to_a)
+               else
+                 arrays['data']
+               end
+        [data, arrays['labels']]
+      end
+
+      # Iterate over the dataset file in batches without loading the whole file into memory.
+      # The batches are read by a background thread, which prepares the next batch while the current one is processed.
+      # This method is useful for training the estimators with partial_fit method on a large dataset.
+      #
+      # @example
+      #   scaler = Rumale::Preprocessing::StandardScaler.new
+      #   Rumale::Dataset.each_batch('train.t', batch_size: 10_000, n_features: 128) { |x, _y| scaler.partial_fit(x) }
+      #
+      # @param filename [String] A path to a dataset file.
+      # @param batch_size [Integer] The number of samples in each batch. The last batch may have fewer samples.
+      # @param format [Symbol] The format of dataset file ('libsvm', 'csv', or 'binary').
+      #   In the csv format, the first column holds labels or target values, and the remaining columns hold features.
+      #   The binary format is the file saved with the save_binary method.
+      # @param n_features [Integer/Nil] The number of features. It is required for the libsvm format
+      #   so that all batches have the same number of columns, and ignored for the other formats.
+      # @param zero_based [Boolean] Whether the column index starts from 0 (true) or 1 (false) in the libsvm format.
+      # @param dtype [Numo::NArray] Data type of Numo::NArray for features in the libsvm and csv formats.
+      # @param sparse [Boolean] The flag indicating whether to yield the features in the libsvm format as a sparse matrix.
+      # @param n_jobs [Integer] The number of threads for parsing each batch in the libsvm format.
+      # @yieldparam x [Numo::NArray/Rumale::CSRMatrix] (shape: [batch_size, n_features]) The feature vectors in the batch.
+      # @yieldparam y [Numo::NArray/Nil] (shape: [batch_size]) The labels or target values in the batch.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of batches.
+      def each_batch(filename, batch_size:, format: :libsvm, n_features: nil, zero_based: false, dtype: Numo::DFloat,
+                     sparse: false, n_jobs: nil, &block)
+        unless block_given?
+          return enum_for(__method__, filename, batch_size: batch_size, format: format, n_features: n_features,
+                                                zero_based: zero_based, dtype: dtype, sparse: sparse, n_jobs: n_jobs)
         end
+
+        Rumale::Validation.check_params_numeric(batch_size: batch_size)
+        Rumale::Validation.check_params_numeric_or_nil(n_features: n_features, n_jobs: n_jobs)
+        Rumale::Validation.check_params_boolean(zero_based: zero_based, sparse: sparse)
+        raise ArgumentError, 'Expect batch_size to be a positive integer' unless batch_size.positive?
+        raise ArgumentError, "Unknown format: #{format}" unless %i[libsvm csv binary].include?(format.to_sym)
+        raise ArgumentError, 'Expect n_features to be given for the libsvm format' if format.to_sym == :libsvm && n_features.nil?
+
+        opts = { n_features: n_features, zero_based: zero_based, dtype: dtype, sparse: sparse, n_threads: n_threads(n_jobs) }
+        read_batches_ahead(filename.to_s, batch_size.to_i, format.to_sym, opts, &block)
       end
 
       # Generate a two-dimensional data set consisting of an inner circle and an outer circle.
@@ -168,13 +260,13 @@ module Rumale
         # generate blobs.
         sz_cluster = [n_samples / n_centers] * n_centers
         (n_samples % n_centers).times { |n| sz_cluster[n] += 1 }
-        x = Rumale::Utils.rand_normal([sz_cluster[0], n_features], rng, 0.0, cluster_std) + centers[0, true]
-        y = Numo::Int32.zeros(sz_cluster[0])
-        (1...n_centers).each do |n|
-          c = Rumale::Utils.rand_normal([sz_cluster[n], n_features], rng, 0.0, cluster_std) + centers[n, true]
-          x = Numo::DFloat.vstack([x, c])
-          y = y.concatenate(Numo::Int32.zeros(sz_cluster[n]) + n)
+        y = Numo::Int32.zeros(n_samples)
+        sz_cluster.each_with_index.inject(0) do |offset, (sz, n)|
+          y[offset...(offset + sz)] = n if sz.positive?
+          offset + sz
         end
+        x = Rumale::Utils.rand_normal([n_samples, n_features], rng, 0.0, cluster_std)
+        x += centers[y, true]
         # shuffle data.
         if shuffle
           rand_ids = Array(0...n_samples).shuffle(random: rng.dup)
@@ -186,61 +278,32 @@ module Rumale
 
       private
 
-      def parse_libsvm_line(line, zero_based)
-        label = parse_label(line.shift)
-        adj_idx = zero_based == false ? 1 : 0
-        max_idx = -1
-        ftvec = []
-        while (el = line.shift)
-          idx, val = el.split(':')
-          idx = idx.to_i - adj_idx
-          val = val.to_i.to_s == val ? val.to_i : val.to_f
-          max_idx = idx if max_idx < idx
-          ftvec.push([idx, val])
-        end
-        [label, ftvec, max_idx]
-      end
+      def libsvm_dataset(parsed, n_features, dtype, sparse)
+        labels, int_labels, data, indices, indptr, = parsed
+        labels = labels.flatten if labels.shape[1] == 1
+        labels = Numo::Int32.cast(labels) if int_labels
+        ftvecs = Rumale::CSRMatrix.new(data, indices, indptr, [labels.shape[0], n_features])
+        return [ftvecs, labels] if sparse
 
-      def parse_label(label)
-        lbl_arr = label.split(',').map { |lbl| lbl.to_i.to_s == lbl ? lbl.to_i : lbl.to_f }
-        lbl_arr.size > 1 ? lbl_arr : lbl_arr[0]
+        ftvecs = ftvecs.to_dense
+        ftvecs = dtype.cast(ftvecs) unless dtype == Numo::DFloat
+        [ftvecs, labels]
       end
 
-      def convert_to_matrix(data, n_features, dtype)
-        mat = []
-        data.each do |ft|
-          vec = Array.new(n_features) { 0 }
-          ft.each { |el| vec[el[0]] = el[1] }
-          mat.push(vec)
-        end
-        dtype.asarray(mat)
+      def n_threads(n_jobs)
+        Rumale::Utils.n_threads(n_jobs)
       end
 
-      def detect_dtype(data)
-        arr_type_str = Numo::NArray.array_type(data).to_s
-        type = '%s'
-        type = '%d' if ['Numo::Int8', 'Numo::Int16', 'Numo::Int32', 'Numo::Int64'].include?(arr_type_str)
-        type = '%d' if ['Numo::UInt8', 'Numo::UInt16', 'Numo::UInt32', 'Numo::UInt64'].include?(arr_type_str)
-        type = '%.10g' if ['Numo::SFloat', 'Numo::DFloat'].include?(arr_type_str)
-        type
+      def integer_array?(data)
+        INTEGER_TYPES.include?(Numo::NArray.array_type(data))
       end
 
-      def dump_libsvm_line(label, ftvec, label_type, value_type, zero_based)
-        line = dump_label(label, label_type.to_s)
-        ftvec.to_a.each_with_index do |val, n|
-          idx = n + (zero_based == false ? 1 : 0)
-          line += format(" %d:#{value_type}", idx, val) if val != 0
-        end
-        line
-      end
-
-      def dump_label(label, label_type_str)
-        if label.is_a?(Array)
-          label.map { |lbl| format(label_type_str, lbl) }.join(',')
-        else
-          format(label_type_str, label)
-        end
+      def contiguous_array(data)
+        data.contiguous? ? data : data.dup
       end
     end
+
+    INTEGER_TYPES = [Numo::Int8, Numo::Int16, Numo::Int32, Numo::Int64, Numo::UInt8, Numo::UInt16, Numo::UInt32, Numo::UInt64].freeze
+    private_constant :INTEGER_TYPES
   end
 end
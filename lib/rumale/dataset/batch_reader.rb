@@ -0,0 +1,113 @@
+# frozen_string_literal: true
+
+module Rumale
+  module Dataset
+    # @!visibility private
+    # The mixin module consisting of the helper methods for reading the dataset file in batches with Dataset.each_batch.
+    # The methods rely on the parsers of ExtDataset and the conversion of Dataset, so this module is extended by Dataset.
+    module BatchReader
+      private
+
+      def read_batches_ahead(filename, batch_size, format, opts)
+        # the queue holding one batch makes the double buffering with the batch being processed by the caller.
+        queue = SizedQueue.new(1)
+        reader = Thread.new do
+          begin
+            case format
+            when :libsvm
+              read_libsvm_batches(filename, batch_size, opts) { |batch| queue.push(batch) }
+            when :csv
+              read_csv_batches(filename, batch_size, opts) { |batch| queue.push(batch) }
+            else
+              read_binary_batches(filename, batch_size) { |batch| queue.push(batch) }
+            end
+            queue.push(nil)
+          rescue StandardError => e
+            queue.push(e)
+          end
+        end
+        while (batch = queue.pop)
+          raise batch if batch.is_a?(Exception)
+
+          yield(*batch)
+        end
+        nil
+      ensure
+        reader&.kill
+        reader&.join
+      end
+
+      def each_text_lines(filename, batch_size)
+        lines = []
+        line_offset = 0
+        n_samples = 0
+        File.foreach(filename) do |line|
+          lines << line
+          next if line.strip.empty? || line.start_with?('#')
+
+          n_samples += 1
+          next if n_samples < batch_size
+
+          yield lines.join, line_offset
+          line_offset += lines.size
+          lines.clear
+          n_samples = 0
+        end
+        yield lines.join, line_offset if n_samples.positive?
+      end
+
+      def read_libsvm_batches(filename, batch_size, opts)
+        each_text_lines(filename, batch_size) do |str, line_offset|
+          parsed = parse_libsvm_string(str, filename, line_offset, opts[:zero_based], opts[:n_threads])
+          raise ArgumentError, "Expect feature index to be less than n_features in #{filename}" if parsed.last >= opts[:n_features]
+
+          yield libsvm_dataset(parsed, opts[:n_features], opts[:dtype], opts[:sparse])
+        end
+      end
+
+      def read_csv_batches(filename, batch_size, opts)
+        each_text_lines(filename, batch_size) do |str, line_offset|
+          lines = str.each_line.with_index(line_offset + 1).reject { |line, _| line.strip.empty? || line.start_with?('#') }
+          values = lines.map { |line, lineno| parse_csv_line(line, lineno, filename) }
+          raise ArgumentError, "Inconsistent number of columns in #{filename}" unless values.map(&:size).uniq.size == 1
+
+          values = Numo::DFloat.cast(values)
+          labels = values[true, 0].dup
+          labels = Numo::Int32.cast(labels) if lines.all? { |line, _| line.split(',', 2).first.strip.match?(/\A[+-]?\d+\z/) }
+          ftvecs = values[true, 1..-1].dup
+          ftvecs = opts[:dtype].cast(ftvecs) unless opts[:dtype] == Numo::DFloat
+          yield [ftvecs, labels]
+        end
+      end
+
+      def parse_csv_line(line, lineno, filename)
+        line.strip.split(',', -1).map { |v| Float(v) }
+      rescue ArgumentError
+        raise ArgumentError, "Invalid value at line #{lineno} of #{filename}"
+      end
+
+      def read_binary_batches(filename, batch_size)
+        shapes = read_binary_shapes(filename)
+        if shapes.key?('csr_indptr')
+          n_samples = shapes['csr_indptr'][0] - 1
+          n_features = read_binary_rows(filename, 'csr_shape' => [1, 2])['csr_shape'][0]
+          (0...n_samples).step(batch_size) do |s|
+            e = [s + batch_size, n_samples].min
+            rows = read_binary_rows(filename, 'csr_indptr' => [s, e + 1], 'labels' => [s, e])
+            indptr = rows['csr_indptr']
+            nz_range = [indptr[0], indptr[-1]]
+            nz = read_binary_rows(filename, 'csr_data' => nz_range, 'csr_indices' => nz_range)
+            yield [Rumale::CSRMatrix.new(nz['csr_data'], nz['csr_indices'], indptr - indptr[0], [e - s, n_features]), rows['labels']]
+          end
+        else
+          n_samples = shapes['data'][0]
+          (0...n_samples).step(batch_size) do |s|
+            e = [s + batch_size, n_samples].min
+            rows = read_binary_rows(filename, 'data' => [s, e], 'labels' => [s, e])
+            yield [rows['data'], rows['labels']]
+          end
+        end
+      end
+    end
+  end
+end
@@ -5,6 +5,7 @@ require 'rumale/utils'
 require 'rumale/base/base_estimator'
 require 'rumale/base/classifier'
 require 'rumale/tree/decision_tree_classifier'
+require 'rumale/ensemble/staged_classifier'
 
 module Rumale
   module Ensemble
@@ -23,6 +24,7 @@ module Rumale
     class AdaBoostClassifier
       include Base::BaseEstimator
       include Base::Classifier
+      include StagedClassifier
 
       # Return the set of estimators.
       # @return [Array<DecisionTreeClassifier>]
@@ -157,9 +159,7 @@ module Rumale
       # @return [Numo::Int32] (shape: [n_samples]) Predicted class label per sample.
       def predict(x)
         x = check_convert_sample_array(x)
-        n_samples, = x.shape
-        probs = decision_function(x)
-        Numo::Int32.asarray(Array.new(n_samples) { |n| @classes[probs[n, true].max_index] })
+        scores_to_labels(decision_function(x))
       end
 
       # Predict probability for samples.
@@ -168,11 +168,39 @@ module Rumale
       # @return [Numo::DFloat] (shape: [n_samples, n_classes]) Predicted probability of each class per sample.
       def predict_proba(x)
         x = check_convert_sample_array(x)
+        scores_to_proba(decision_function(x))
+      end
+
+      # Calculate confidence scores for samples at each stage of boosting, that is, each time an estimator is added.
+      # The scores at the t-th stage are the same as those of the classifier learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to compute the scores.
+      # @yieldparam scores [Numo::DFloat] (shape: [n_samples, n_classes]) Confidence score per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of scores at each stage.
+      def staged_decision_function(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        n_samples, = x.shape
         n_classes = @classes.size
-        probs = Numo::NMath.exp(1.fdiv(n_classes - 1) * decision_function(x))
-        sum_probs = probs.sum(1)
-        probs /= Numo::DFloat[sum_probs].transpose
-        probs
+        sum_probs = Numo::DFloat.zeros(n_samples, n_classes)
+        @estimators.each_with_index do |tree, t|
+          log_proba = Numo::NMath.log(tree.predict_proba(x).clip(1.0e-15, nil))
+          sum_probs += (n_classes - 1) * (log_proba - 1.fdiv(n_classes) * Numo::DFloat[log_proba.sum(1)].transpose)
+          yield sum_probs / (t + 1)
+        end
+      end
+
+      private
+
+      def scores_to_proba(scores)
+        probs = Numo::NMath.exp(1.fdiv(@classes.size - 1) * scores)
+        probs / Numo::DFloat[probs.sum(1)].transpose
+      end
+
+      # the class label with the highest score is the same as that with the highest probability.
+      def scores_to_labels(scores)
+        proba_to_labels(scores)
       end
     end
   end
@@ -155,6 +155,26 @@ module Rumale
         sum_weight = @estimator_weights.sum
         predictions / sum_weight
       end
+
+      # Predict values for samples at each stage of boosting, that is, each time an estimator is added.
+      # The values at the t-th stage are the same as those of the regressor learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
+      # @yieldparam predicted [Numo::DFloat] (shape: [n_samples]) Predicted value per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of values at each stage.
+      def staged_predict(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        n_samples, = x.shape
+        predictions = Numo::DFloat.zeros(n_samples)
+        sum_weight = 0.0
+        @estimators.size.times do |t|
+          predictions += @estimator_weights[t] * @estimators[t].predict(x)
+          sum_weight += @estimator_weights[t]
+          yield predictions / sum_weight
+        end
+      end
     end
   end
 end
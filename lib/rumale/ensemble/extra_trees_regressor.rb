@@ -93,6 +93,14 @@ module Rumale
         self
       end
 
+      # Return whether the fit method accepts the sample_indices keyword argument.
+      # Extremely randomized trees are fitted on the whole given samples without bootstrap sampling, so it does not.
+      #
+      # @return [Boolean]
+      def supports_sample_indices?
+        false
+      end
+
       # Predict values for samples.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
@@ -4,6 +4,7 @@ require 'rumale/values'
 require 'rumale/base/base_estimator'
 require 'rumale/base/classifier'
 require 'rumale/tree/gradient_tree_regressor'
+require 'rumale/ensemble/staged_classifier'
 
 module Rumale
   module Ensemble
@@ -26,6 +27,7 @@ module Rumale
     class GradientBoostingClassifier
       include Base::BaseEstimator
       include Base::Classifier
+      include StagedClassifier
 
       # Return the set of estimators.
       # @return [Array<GradientTreeRegressor>] or [Array<Array<GradientTreeRegressor>>]
@@ -147,9 +149,7 @@ module Rumale
       # @return [Numo::Int32] (shape: [n_samples]) Predicted class label per sample.
       def predict(x)
         x = check_convert_sample_array(x)
-        n_samples = x.shape[0]
-        probs = predict_proba(x)
-        Numo::Int32.asarray(Array.new(n_samples) { |n| @classes[probs[n, true].max_index] })
+        proba_to_labels(predict_proba(x))
       end
 
       # Predict probability for samples.
@@ -158,16 +158,34 @@ module Rumale
       # @return [Numo::DFloat] (shape: [n_samples, n_classes]) Predicted probability of each class per sample.
       def predict_proba(x)
         x = check_convert_sample_array(x)
+        scores_to_proba(decision_function(x))
+      end
 
-        proba = 1.0 / (Numo::NMath.exp(-decision_function(x)) + 1.0)
-
-        return (proba.transpose / proba.sum(axis: 1)).transpose.dup if @classes.size > 2
+      # Calculate confidence scores for samples at each stage of boosting, that is, each time a tree is added.
+      # The scores at the t-th stage are the same as those of the classifier learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to compute the scores.
+      # @yieldparam scores [Numo::DFloat] (shape: [n_samples, n_classes]) Confidence score per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of scores at each stage.
+      def staged_decision_function(x)
+        return enum_for(__method__, x) unless block_given?
 
-        n_samples, = x.shape
-        probs = Numo::DFloat.zeros(n_samples, 2)
-        probs[true, 1] = proba
-        probs[true, 0] = 1.0 - proba
-        probs
+        x = check_convert_sample_array(x)
+        if @classes.size > 2
+          # the scores are summed up in the same order as the decision_function method.
+          sum_scores = nil
+          @estimators.first.size.times do |t|
+            tree_scores = @estimators.map { |trees| trees[t].predict(x) }
+            sum_scores = sum_scores.nil? ? tree_scores : sum_scores.zip(tree_scores).map { |a, b| a + b }
+            yield Numo::DFloat.asarray(sum_scores).transpose + @base_predictions
+          end
+        else
+          sum_scores = nil
+          @estimators.each do |tree|
+            sum_scores = sum_scores.nil? ? tree.predict(x) : sum_scores + tree.predict(x)
+            yield sum_scores + @base_predictions
+          end
+        end
       end
 
       # Return the index of the leaf that each sample reached.
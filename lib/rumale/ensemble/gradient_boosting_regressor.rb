@@ -132,6 +132,33 @@ module Rumale
         end
       end
 
+      # Predict values for samples at each stage of boosting, that is, each time a tree is added.
+      # The values at the t-th stage are the same as those of the regressor learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
+      # @yieldparam predicted [Numo::DFloat] (shape: [n_samples]) Predicted values per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of values at each stage.
+      def staged_predict(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        if @estimators.first.is_a?(Array)
+          # the values are summed up in the same order as the predict method.
+          sum_values = nil
+          @estimators.first.size.times do |t|
+            tree_values = @estimators.map { |trees| trees[t].predict(x) }
+            sum_values = sum_values.nil? ? tree_values : sum_values.zip(tree_values).map { |a, b| a + b }
+            yield Numo::DFloat.asarray(sum_values).transpose + @base_predictions
+          end
+        else
+          sum_values = nil
+          @estimators.each do |tree|
+            sum_values = sum_values.nil? ? tree.predict(x) : sum_values + tree.predict(x)
+            yield sum_values + @base_predictions
+          end
+        end
+      end
+
       # Return the index of the leaf that each sample reached.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
@@ -84,16 +84,21 @@ module Rumale
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The training data to be used for fitting the model.
       # @param y [Numo::Int32] (shape: [n_samples]) The labels to be used for fitting the model.
+      # @param sample_indices [Array<Integer>] The indices of samples to be used for fitting the model.
+      #   If nil is given, all samples are used. The subset is not copied, since each tree is fitted on
+      #   the bootstrap samples drawn from the indices.
       # @return [RandomForestClassifier] The learned classifier itself.
-      def fit(x, y) # rubocop:disable Metrics/AbcSize
+      def fit(x, y, sample_indices: nil) # rubocop:disable Metrics/AbcSize
         x = check_convert_sample_array(x)
         y = check_convert_label_array(y)
         check_sample_label_size(x, y)
         # Initialize some variables.
-        n_samples, n_features = x.shape
+        n_features = x.shape[1]
+        sample_ids = sample_indices.nil? ? nil : check_sample_indices(sample_indices, x.shape[0])
+        n_samples = sample_ids.nil? ? x.shape[0] : sample_ids.size
         @params[:max_features] = Math.sqrt(n_features).to_i if @params[:max_features].nil?
         @params[:max_features] = [[1, @params[:max_features]].max, n_features].min
-        @classes = Numo::Int32.asarray(y.to_a.uniq.sort)
+        @classes = Numo::Int32.asarray((sample_ids.nil? ? y : y[sample_ids]).to_a.uniq.sort)
         sub_rng = @rng.dup
         rngs = Array.new(@params[:n_estimators]) { Random.new(sub_rng.rand(Rumale::Values.int_max)) }
         # Construct forest.
@@ -101,13 +106,13 @@ module Rumale
           if enable_parallel?
             # :nocov:
             parallel_map(@params[:n_estimators]) do |n|
-              bootstrap_ids = Array.new(n_samples) { rngs[n].rand(0...n_samples) }
+              bootstrap_ids = bootstrap_sample_ids(rngs[n], n_samples, sample_ids)
               plant_tree(rngs[n].rand(Rumale::Values.int_max)).fit(x[bootstrap_ids, true], y[bootstrap_ids])
             end
             # :nocov:
           else
             Array.new(@params[:n_estimators]) do |n|
-              bootstrap_ids = Array.new(n_samples) { rngs[n].rand(0...n_samples) }
+              bootstrap_ids = bootstrap_sample_ids(rngs[n], n_samples, sample_ids)
               plant_tree(rngs[n].rand(Rumale::Values.int_max)).fit(x[bootstrap_ids, true], y[bootstrap_ids])
             end
           end
@@ -121,22 +126,27 @@ module Rumale
         self
       end
 
+      # Return whether the fit method accepts the indices of samples to be used for fitting with the sample_indices keyword argument.
+      # The cross validation fits the estimator on the whole dataset with the indices of training samples if this method returns true.
+      #
+      # @return [Boolean]
+      def supports_sample_indices?
+        true
+      end
+
       # Predict class labels for samples.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the labels.
       # @return [Numo::Int32] (shape: [n_samples]) Predicted class label per sample.
       def predict(x)
         x = check_convert_sample_array(x)
-        n_samples = x.shape[0]
-        n_estimators = @estimators.size
-        predicted = if enable_parallel?
-                      predict_set = parallel_map(n_estimators) { |n| @estimators[n].predict(x).to_a }.transpose
-                      parallel_map(n_samples) { |n| predict_set[n].group_by { |v| v }.max_by { |_k, v| v.size }.first }
-                    else
-                      predict_set = @estimators.map { |tree| tree.predict(x).to_a }.transpose
-                      Array.new(n_samples) { |n| predict_set[n].group_by { |v| v }.max_by { |_k, v| v.size }.first }
-                    end
-        Numo::Int32.asarray(predicted)
+        votes = Numo::Int32.zeros(x.shape[0], @classes.size)
+        if enable_parallel?
+          parallel_map(@estimators.size) { |n| tree_vote_ids(@estimators[n], x) }.each { |vote_ids| votes[vote_ids] += 1 }
+        else
+          @estimators.each { |tree| votes[tree_vote_ids(tree, x)] += 1 }
+        end
+        votes_to_labels(votes)
       end
 
       # Predict probability for samples.
@@ -153,6 +163,40 @@ module Rumale
         end
       end
 
+      # Predict class labels for samples at each stage, that is, each time a tree is added to the forest.
+      # The labels at the t-th stage are the same as those of the classifier learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the labels.
+      # @yieldparam predicted [Numo::Int32] (shape: [n_samples]) Predicted class label per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of labels at each stage.
+      def staged_predict(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        votes = Numo::Int32.zeros(x.shape[0], @classes.size)
+        @estimators.each do |tree|
+          votes[tree_vote_ids(tree, x)] += 1
+          yield votes_to_labels(votes)
+        end
+      end
+
+      # Predict probability for samples at each stage, that is, each time a tree is added to the forest.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the probailities.
+      # @yieldparam probs [Numo::DFloat] (shape: [n_samples, n_classes]) Predicted probability of each class per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of probabilities at each stage.
+      def staged_predict_proba(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        sum_probs = nil
+        @estimators.each_with_index do |tree, t|
+          probs = predict_proba_tree(tree, x)
+          sum_probs = sum_probs.nil? ? probs : sum_probs + probs
+          yield sum_probs / (t + 1)
+        end
+      end
+
       # Return the index of the leaf that each sample reached.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the labels.
@@ -164,6 +208,20 @@ module Rumale
 
       private
 
+      def check_sample_indices(sample_indices, n_samples)
+        sample_ids = sample_indices.to_a
+        unless !sample_ids.empty? && sample_ids.all? { |i| i.is_a?(Integer) && i >= 0 && i < n_samples }
+          raise ArgumentError, 'Expect sample indices to be the non-empty array of integers in the range of the number of samples'
+        end
+
+        sample_ids
+      end
+
+      def bootstrap_sample_ids(rng, n_samples, sample_ids)
+        bootstrap_ids = Array.new(n_samples) { rng.rand(0...n_samples) }
+        sample_ids.nil? ? bootstrap_ids : bootstrap_ids.map { |i| sample_ids[i] }
+      end
+
       def plant_tree(rnd_seed)
         Tree::DecisionTreeClassifier.new(
           criterion: @params[:criterion], max_depth: @params[:max_depth],
@@ -172,6 +230,20 @@ module Rumale
         )
       end
 
+      # The flat indices of the votes buffer, that is, sample index * n_classes + class index, for the labels predicted by the tree.
+      def tree_vote_ids(tree, x)
+        class_ids = @classes.to_a.each_with_index.with_object({}) { |(label, i), obj| obj[label] = i }
+        leaf_class_ids = Numo::Int32.asarray(tree.leaf_labels.to_a.map { |label| class_ids[label] })
+        leaf_class_ids[tree.apply(x)] + Numo::Int32.new(x.shape[0]).seq * @classes.size
+      end
+
+      # The ties of votes are broken by choosing the class with the smallest label.
+      def votes_to_labels(votes)
+        n_samples = votes.shape[0]
+        label_ids = votes.max_index(axis: 1) - Numo::Int32.new(n_samples).seq * @classes.size
+        @classes[label_ids].dup
+      end
+
       def predict_proba_tree(tree, x)
         # initialize some variables.
         n_samples = x.shape[0]
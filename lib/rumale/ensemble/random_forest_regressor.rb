@@ -78,13 +78,18 @@ module Rumale
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The training data to be used for fitting the model.
       # @param y [Numo::DFloat] (shape: [n_samples, n_outputs]) The target values to be used for fitting the model.
+      # @param sample_indices [Array<Integer>] The indices of samples to be used for fitting the model.
+      #   If nil is given, all samples are used. The subset is not copied, since each tree is fitted on
+      #   the bootstrap samples drawn from the indices.
       # @return [RandomForestRegressor] The learned regressor itself.
-      def fit(x, y) # rubocop:disable Metrics/AbcSize
+      def fit(x, y, sample_indices: nil) # rubocop:disable Metrics/AbcSize
         x = check_convert_sample_array(x)
         y = check_convert_tvalue_array(y)
         check_sample_tvalue_size(x, y)
         # Initialize some variables.
-        n_samples, n_features = x.shape
+        n_features = x.shape[1]
+        sample_ids = sample_indices.nil? ? nil : check_sample_indices(sample_indices, x.shape[0])
+        n_samples = sample_ids.nil? ? x.shape[0] : sample_ids.size
         @params[:max_features] = Math.sqrt(n_features).to_i if @params[:max_features].nil?
         @params[:max_features] = [[1, @params[:max_features]].max, n_features].min
         single_target = y.shape[1].nil?
@@ -95,14 +100,14 @@ module Rumale
           if enable_parallel?
             # :nocov:
             parallel_map(@params[:n_estimators]) do |n|
-              bootstrap_ids = Array.new(n_samples) { rngs[n].rand(0...n_samples) }
+              bootstrap_ids = bootstrap_sample_ids(rngs[n], n_samples, sample_ids)
               tree = plant_tree(rngs[n].rand(Rumale::Values.int_max))
               tree.fit(x[bootstrap_ids, true], single_target ? y[bootstrap_ids] : y[bootstrap_ids, true])
             end
             # :nocov:
           else
             Array.new(@params[:n_estimators]) do |n|
-              bootstrap_ids = Array.new(n_samples) { rngs[n].rand(0...n_samples) }
+              bootstrap_ids = bootstrap_sample_ids(rngs[n], n_samples, sample_ids)
               tree = plant_tree(rngs[n].rand(Rumale::Values.int_max))
               tree.fit(x[bootstrap_ids, true], single_target ? y[bootstrap_ids] : y[bootstrap_ids, true])
             end
@@ -117,6 +122,14 @@ module Rumale
         self
       end
 
+      # Return whether the fit method accepts the indices of samples to be used for fitting with the sample_indices keyword argument.
+      # The cross validation fits the estimator on the whole dataset with the indices of training samples if this method returns true.
+      #
+      # @return [Boolean]
+      def supports_sample_indices?
+        true
+      end
+
       # Predict values for samples.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
@@ -130,6 +143,24 @@ module Rumale
         end
       end
 
+      # Predict values for samples at each stage, that is, each time a tree is added to the forest.
+      # The values at the t-th stage are the same as those of the regressor learned with t estimators.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the values.
+      # @yieldparam predicted [Numo::DFloat] (shape: [n_samples, n_outputs]) Predicted value per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of values at each stage.
+      def staged_predict(x)
+        return enum_for(__method__, x) unless block_given?
+
+        x = check_convert_sample_array(x)
+        sum_values = nil
+        @estimators.each_with_index do |tree, t|
+          values = tree.predict(x)
+          sum_values = sum_values.nil? ? values : sum_values + values
+          yield sum_values / (t + 1)
+        end
+      end
+
       # Return the index of the leaf that each sample reached.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to assign each leaf.
@@ -141,6 +172,20 @@ module Rumale
 
       private
 
+      def check_sample_indices(sample_indices, n_samples)
+        sample_ids = sample_indices.to_a
+        unless !sample_ids.empty? && sample_ids.all? { |i| i.is_a?(Integer) && i >= 0 && i < n_samples }
+          raise ArgumentError, 'Expect sample indices to be the non-empty array of integers in the range of the number of samples'
+        end
+
+        sample_ids
+      end
+
+      def bootstrap_sample_ids(rng, n_samples, sample_ids)
+        bootstrap_ids = Array.new(n_samples) { rng.rand(0...n_samples) }
+        sample_ids.nil? ? bootstrap_ids : bootstrap_ids.map { |i| sample_ids[i] }
+      end
+
       def plant_tree(rnd_seed)
         Tree::DecisionTreeRegressor.new(
           criterion: @params[:criterion], max_depth: @params[:max_depth],
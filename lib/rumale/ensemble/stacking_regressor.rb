@@ -42,12 +42,16 @@ module Rumale
       # @param n_splits [Integer] The number of folds for cross validation with k-fold on meta feature extraction in training phase.
       # @param shuffle [Boolean] The flag indicating whether to shuffle the dataset on cross validation.
       # @param passthrough [Boolean] The flag indicating whether to concatenate the original features and meta features when training the meta regressor.
+      # @param n_jobs [Integer] The number of jobs for fitting the base regressors on all training data and each fold in parallel.
+      #   If nil is given, the method does not execute in parallel.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
       # @param random_seed [Integer/Nil] The seed value using to initialize the random generator on cross validation.
-      def initialize(estimators:, meta_estimator: nil, n_splits: 5, shuffle: true, passthrough: false, random_seed: nil)
+      def initialize(estimators:, meta_estimator: nil, n_splits: 5, shuffle: true, passthrough: false, n_jobs: nil, random_seed: nil)
         check_params_type(Hash, estimators: estimators)
         check_params_numeric(n_splits: n_splits)
         check_params_boolean(shuffle: shuffle, passthrough: passthrough)
-        check_params_numeric_or_nil(random_seed: random_seed)
+        check_params_numeric_or_nil(n_jobs: n_jobs, random_seed: random_seed)
         @estimators = estimators
         @meta_estimator = meta_estimator || Rumale::LinearModel::Ridge.new
         @output_size = nil
@@ -55,6 +59,7 @@ module Rumale
         @params[:n_splits] = n_splits
         @params[:shuffle] = shuffle
         @params[:passthrough] = passthrough
+        @params[:n_jobs] = n_jobs
         @params[:random_seed] = random_seed || srand
       end
 
@@ -69,35 +74,20 @@ module Rumale
         check_sample_tvalue_size(x, y)
 
         n_samples, n_features = x.shape
-        n_outputs = y.ndim == 1 ? 1 : y.shape[1]
-
-        # training base regressors with all training data.
-        @estimators.each_key { |name| @estimators[name].fit(x, y) }
-
-        # detecting size of output for each base regressor.
-        @output_size = detect_output_size(n_features)
-
-        # extracting meta features with base regressors.
-        n_components = @output_size.values.inject(:+)
-        z = Numo::DFloat.zeros(n_samples, n_components)
 
+        # training base regressors with all training data and on each fold for extracting meta features.
         kf = Rumale::ModelSelection::KFold.new(
           n_splits: @params[:n_splits], shuffle: @params[:shuffle], random_seed: @params[:random_seed]
         )
+        splits = kf.split(x, y)
+        fitted, fold_outputs = fit_base_estimators(x, y, splits)
+        fitted.each { |name, est| @estimators[name] = est }
 
-        kf.split(x, y).each do |train_ids, valid_ids|
-          x_train = x[train_ids, true]
-          y_train = n_outputs == 1 ? y[train_ids] : y[train_ids, true]
-          x_valid = x[valid_ids, true]
-          f_start = 0
-          @estimators.each_key do |name|
-            est_fold = Marshal.load(Marshal.dump(@estimators[name]))
-            f_last = f_start + @output_size[name]
-            f_position = @output_size[name] == 1 ? f_start : f_start...f_last
-            z[valid_ids, f_position] = est_fold.fit(x_train, y_train).predict(x_valid)
-            f_start = f_last
-          end
-        end
+        # detecting size of output for each base regressor.
+        @output_size = detect_output_size(n_features)
+
+        # assembling meta features with the outputs of base regressors trained on each fold.
+        z = assemble_meta_features(n_samples, splits, fold_outputs)
 
         # concatenating original features.
         z = Numo::NArray.hstack([z, x]) if @params[:passthrough]
@@ -151,6 +141,46 @@ module Rumale
 
       private
 
+      # Each pair of base regressor and training data, that is all training data or the training data of each fold,
+      # is an independent task, and the tasks are performed in parallel if n_jobs is given.
+      # The estimators on each fold are copied from the prototypes taken before any task runs,
+      # so that they start from the same state regardless of the order of tasks.
+      def fit_base_estimators(x, y, splits)
+        names = @estimators.keys
+        prototypes = names.each_with_object({}) { |name, obj| obj[name] = Marshal.dump(@estimators[name]) }
+        tasks = names.map { |name| [name, nil] } + names.product(Array(0...splits.size))
+        outputs = if enable_parallel?
+                    parallel_map(tasks.size) { |t| fit_base_estimator(x, y, splits, prototypes, *tasks[t]) }
+                  else
+                    tasks.map { |name, split_id| fit_base_estimator(x, y, splits, prototypes, name, split_id) }
+                  end
+        fitted = names.zip(outputs.shift(names.size)).to_h
+        fold_outputs = names.zip(outputs.each_slice(splits.size).to_a).to_h
+        [fitted, fold_outputs]
+      end
+
+      def fit_base_estimator(x, y, splits, prototypes, name, split_id)
+        return @estimators[name].fit(x, y) if split_id.nil?
+
+        train_ids, valid_ids = splits[split_id]
+        y_train = y.ndim == 1 ? y[train_ids] : y[train_ids, true]
+        est_fold = Marshal.load(prototypes[name])
+        est_fold.fit(x[train_ids, true], y_train).predict(x[valid_ids, true])
+      end
+
+      def assemble_meta_features(n_samples, splits, fold_outputs)
+        n_components = @output_size.values.inject(:+)
+        z = Numo::DFloat.zeros(n_samples, n_components)
+        f_start = 0
+        @estimators.each_key do |name|
+          f_last = f_start + @output_size[name]
+          f_position = @output_size[name] == 1 ? f_start : f_start...f_last
+          splits.each_with_index { |(_train_ids, valid_ids), s| z[valid_ids, f_position] = fold_outputs[name][s] }
+          f_start = f_last
+        end
+        z
+      end
+
       def detect_output_size(n_features)
         x_dummy = Numo::DFloat.new(2, n_features).rand
         @estimators.each_key.with_object({}) do |name, obj|
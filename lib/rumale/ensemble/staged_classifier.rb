@@ -0,0 +1,57 @@
+# frozen_string_literal: true
+
+module Rumale
+  module Ensemble
+    # StagedClassifier is a module that provides the staged prediction methods for boosting classifiers.
+    # The class including this module must implement the staged_decision_function method and have the class labels in @classes.
+    # The confidence scores are converted to the probabilities with the logistic function by default,
+    # and the class can override the scores_to_proba and scores_to_labels methods to change the conversion.
+    module StagedClassifier
+      # Predict class labels for samples at each stage of boosting.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the labels.
+      # @yieldparam predicted [Numo::Int32] (shape: [n_samples]) Predicted class label per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of labels at each stage.
+      def staged_predict(x)
+        return enum_for(__method__, x) unless block_given?
+
+        staged_decision_function(x) { |scores| yield scores_to_labels(scores) }
+      end
+
+      # Predict probability for samples at each stage of boosting.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to predict the probailities.
+      # @yieldparam probs [Numo::DFloat] (shape: [n_samples, n_classes]) Predicted probability of each class per sample at the stage.
+      # @return [Enumerator] If block is not given, this method returns the enumerator of probabilities at each stage.
+      def staged_predict_proba(x)
+        return enum_for(__method__, x) unless block_given?
+
+        staged_decision_function(x) { |scores| yield scores_to_proba(scores) }
+      end
+
+      private
+
+      def scores_to_proba(scores)
+        proba = 1.0 / (Numo::NMath.exp(-scores) + 1.0)
+
+        return (proba.transpose / proba.sum(axis: 1)).transpose.dup if @classes.size > 2
+
+        n_samples, = scores.shape
+        probs = Numo::DFloat.zeros(n_samples, 2)
+        probs[true, 1] = proba
+        probs[true, 0] = 1.0 - proba
+        probs
+      end
+
+      def scores_to_labels(scores)
+        proba_to_labels(scores_to_proba(scores))
+      end
+
+      def proba_to_labels(probs)
+        n_samples = probs.shape[0]
+        label_ids = probs.max_index(axis: 1) - Numo::Int32.new(n_samples).seq * probs.shape[1]
+        @classes[label_ids].dup
+      end
+    end
+  end
+end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/classifier'
+require 'rumale/base/member_estimators'
 require 'rumale/preprocessing/label_encoder'
 
 module Rumale
@@ -25,6 +26,7 @@ module Rumale
     class VotingClassifier
       include Base::BaseEstimator
       include Base::Classifier
+      include Base::MemberEstimators
 
       # Return the sub-classifiers that voted.
       # @return [Hash<Symbol,Classifier>]
@@ -41,15 +43,21 @@ module Rumale
       # @param voting [String] The voting rule for the predicted results of each classifier.
       #   If 'hard' is given, the ensembled classifier predicts the class label by majority vote.
       #   If 'soft' is given, the ensembled classifier uses the weighted average of predicted probabilities for the prediction.
-      def initialize(estimators:, weights: nil, voting: 'hard')
+      # @param n_jobs [Integer] The number of jobs for running the fit and predict methods of sub-classifiers in parallel.
+      #   If nil is given, the methods do not execute in parallel.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      def initialize(estimators:, weights: nil, voting: 'hard', n_jobs: nil)
         check_params_type(Hash, estimators: estimators)
         check_params_type_or_nil(Hash, weights: weights)
         check_params_string(voting: voting)
+        check_params_numeric_or_nil(n_jobs: n_jobs)
         @estimators = estimators
         @classes = nil
         @params = {}
         @params[:weights] = weights || estimators.each_key.with_object({}) { |name, w| w[name] = 1.0 }
         @params[:voting] = voting
+        @params[:n_jobs] = n_jobs
       end
 
       # Fit the model with given training data.
@@ -65,7 +73,7 @@ module Rumale
         @encoder = Rumale::Preprocessing::LabelEncoder.new
         y_encoded = @encoder.fit_transform(y)
         @classes = Numo::NArray[*@encoder.classes]
-        @estimators.each_key { |name| @estimators[name].fit(x, y_encoded) }
+        fit_members(@estimators, x, y_encoded)
 
         self
       end
@@ -81,8 +89,8 @@ module Rumale
         n_samples = x.shape[0]
         n_classes = @classes.size
         z = Numo::DFloat.zeros(n_samples, n_classes)
-        @estimators.each do |name, estimator|
-          estimator.predict(x).to_a.each_with_index { |c, i| z[i, c] += @params[:weights][name] }
+        each_member_output(@estimators, :predict, x) do |name, predicted|
+          predicted.to_a.each_with_index { |c, i| z[i, c] += @params[:weights][name] }
         end
         z
       end
@@ -110,8 +118,8 @@ module Rumale
         n_classes = @classes.size
         z = Numo::DFloat.zeros(n_samples, n_classes)
         sum_weight = @params[:weights].each_value.inject(&:+)
-        @estimators.each do |name, estimator|
-          z += @params[:weights][name] * estimator.predict_proba(x)
+        each_member_output(@estimators, :predict_proba, x) do |name, probs|
+          z += @params[:weights][name] * probs
         end
         z /= sum_weight
       end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/regressor'
+require 'rumale/base/member_estimators'
 
 module Rumale
   module Ensemble
@@ -24,6 +25,7 @@ module Rumale
     class VotingRegressor
       include Base::BaseEstimator
       include Base::Regressor
+      include Base::MemberEstimators
 
       # Return the sub-regressors that voted.
       # @return [Hash<Symbol,Regressor>]
@@ -33,13 +35,19 @@ module Rumale
       #
       # @param estimators [Hash<Symbol,Regressor>] The sub-regressors to vote.
       # @param weights [Hash<Symbol,Float>] The weight value for each regressor.
-      def initialize(estimators:, weights: nil)
+      # @param n_jobs [Integer] The number of jobs for running the fit and predict methods of sub-regressors in parallel.
+      #   If nil is given, the methods do not execute in parallel.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      def initialize(estimators:, weights: nil, n_jobs: nil)
         check_params_type(Hash, estimators: estimators)
         check_params_type_or_nil(Hash, weights: weights)
+        check_params_numeric_or_nil(n_jobs: n_jobs)
         @estimators = estimators
         @n_outputs = nil
         @params = {}
         @params[:weights] = weights || estimators.each_key.with_object({}) { |name, w| w[name] = 1.0 }
+        @params[:n_jobs] = n_jobs
       end
 
       # Fit the model with given training data.
@@ -53,7 +61,7 @@ module Rumale
         check_sample_tvalue_size(x, y)
 
         @n_outputs = y.ndim > 1 ? y.shape[1] : 1
-        @estimators.each_key { |name| @estimators[name].fit(x, y) }
+        fit_members(@estimators, x, y)
 
         self
       end
@@ -66,8 +74,8 @@ module Rumale
         x = check_convert_sample_array(x)
         z = single_target? ? Numo::DFloat.zeros(x.shape[0]) : Numo::DFloat.zeros(x.shape[0], @n_outputs)
         sum_weight = @params[:weights].each_value.inject(&:+)
-        @estimators.each do |name, estimator|
-          z += @params[:weights][name] * estimator.predict(x)
+        each_member_output(@estimators, :predict, x) do |name, predicted|
+          z += @params[:weights][name] * predicted
         end
         z / sum_weight
       end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/csr_matrix'
 
 module Rumale
   # This module consists of the classes that extract features from raw data.
@@ -37,6 +38,7 @@ module Rumale
     class HashVectorizer
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtHashVectorizer
 
       # Return the list of feature names.
       # @return [Array] (size: [n_features])
@@ -50,12 +52,14 @@ module Rumale
       #
       # @param separator [String] The separator string used for constructing new feature names for categorical feature.
       # @param sort [Boolean] The flag indicating whether to sort feature names.
-      def initialize(separator: '=', sort: true)
+      # @param sparse [Boolean] The flag indicating whether to return the encoded samples as sparse matrix in CSR format.
+      def initialize(separator: '=', sort: true, sparse: false)
         check_params_string(separator: separator)
-        check_params_boolean(sort: sort)
+        check_params_boolean(sort: sort, sparse: sparse)
         @params = {}
         @params[:separator] = separator
         @params[:sort] = sort
+        @params[:sparse] = sparse
       end
 
       # Fit the encoder with given training data.
@@ -64,18 +68,8 @@ module Rumale
       #   @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
       #   @return [HashVectorizer]
       def fit(x, _y = nil)
-        @feature_names = []
-        @vocabulary = {}
-
-        x.each do |f|
-          f.each do |k, v|
-            k = "#{k}#{separator}#{v}".to_sym if v.is_a?(String)
-            next if @vocabulary.key?(k)
-
-            @feature_names.push(k)
-            @vocabulary[k] = @vocabulary.size
-          end
-        end
+        x = [x] unless x.is_a?(Array)
+        @feature_names, @vocabulary = build_vocabulary(x, separator)
 
         if sort_feature?
           @feature_names.sort!
@@ -89,7 +83,7 @@ module Rumale
       #
       # @overload fit_transform(x) -> Numo::DFloat
       #   @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
-      #   @return [Numo::DFloat] (shape: [n_samples, n_features]) The encoded sample array.
+      #   @return [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The encoded sample array.
       def fit_transform(x, _y = nil)
         fit(x).transform(x)
       end
@@ -97,43 +91,33 @@ module Rumale
       # Encode given the array of feature-value hash.
       #
       # @param x [Array<Hash>] (shape: [n_samples]) The array of hash consisting of feature names and values.
-      # @return [Numo::DFloat] (shape: [n_samples, n_features]) The encoded sample array.
+      # @return [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The encoded sample array.
       def transform(x)
         x = [x] unless x.is_a?(Array)
-        n_samples = x.size
-        n_features = @vocabulary.size
-        z = Numo::DFloat.zeros(n_samples, n_features)
-
-        x.each_with_index do |f, i|
-          f.each do |k, v|
-            if v.is_a?(String)
-              k = "#{k}#{separator}#{v}".to_sym
-              v = 1
-            end
-            z[i, @vocabulary[k]] = v if @vocabulary.key?(k)
-          end
-        end
-
-        z
+        data, indices, indptr = vectorize_features(x, @vocabulary, separator)
+        z = Rumale::CSRMatrix.new(data, indices, indptr, [x.size, @vocabulary.size])
+        @params[:sparse] ? z : z.to_dense
       end
 
       # Decode sample matirx to the array of feature-value hash.
       #
-      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The encoded sample array.
+      # @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The encoded sample array.
       # @return [Array<Hash>] The array of hash consisting of feature names and values.
       def inverse_transform(x)
-        n_samples = x.shape[0]
-        reconst = []
+        x = Rumale::CSRMatrix.from_dense(x) unless x.is_a?(Rumale::CSRMatrix)
+        decoded = @feature_names.map { |fname| feature_key_val(fname, nil).tap { |f| f[0] = f[0].to_sym } }
+        data = x.data.to_a
+        indices = x.indices.to_a
+        indptr = x.indptr.to_a
 
-        n_samples.times do |i|
+        Array.new(x.shape[0]) do |i|
           f = {}
-          x[i, true].each_with_index do |el, j|
-            feature_key_val(@feature_names[j], el).tap { |k, v| f[k.to_sym] = v } unless el.zero?
+          (indptr[i]...indptr[i + 1]).each do |j|
+            k, v = decoded[indices[j]]
+            f[k] = v.nil? ? data[j] : v
           end
-          reconst.push(f)
+          f
         end
-
-        reconst
       end
 
       private
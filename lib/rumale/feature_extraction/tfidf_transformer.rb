@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/csr_matrix'
 require 'rumale/preprocessing/l1_normalizer'
 require 'rumale/preprocessing/l2_normalizer'
 
@@ -29,11 +30,16 @@ module Rumale
     #   # [[0.959056, 0, 0.283217],
     #   #  [0, 0.491506, 0.870874]]
     #
+    #   # The sparse matrix in CSR format can also be given, and then the transformed one is returned in the same format.
+    #   encoder = Rumale::FeatureExtraction::HashVectorizer.new(sparse: true)
+    #   x_tfidf = transformer.fit_transform(encoder.fit_transform(documents))
+    #
     # *Reference*
     # - Manning, C D., Raghavan, P., and Schutze, H., "Introduction to Information Retrieval," Cambridge University Press., 2008.
     class TfidfTransformer
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtTfidfTransformer
 
       # Return the vector consists of inverse document frequency.
       # @return [Numo::DFloat] (shape: [n_features])
@@ -60,15 +66,19 @@ module Rumale
       #
       # @overload fit(x) -> TfidfTransformer
       #
-      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to calculate the idf values.
+      # @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The samples to calculate the idf values.
       # @return [TfidfTransformer]
       def fit(x, _y = nil)
         return self unless @params[:use_idf]
 
-        x = check_convert_sample_array(x)
-
         n_samples = x.shape[0]
-        df = x.class.cast(x.gt(0.0).count(0))
+        if x.is_a?(Rumale::CSRMatrix)
+          df = Numo::DFloat.zeros(x.shape[1])
+          csr_document_frequency(x.data, x.indices, df)
+        else
+          x = check_convert_sample_array(x)
+          df = x.class.cast(x.gt(0.0).count(0))
+        end
 
         if @params[:smooth_idf]
           df += 1
@@ -84,30 +94,52 @@ module Rumale
       #
       # @overload fit_transform(x) -> Numo::DFloat
       #
-      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to calculate idf and be transformed to tf-idf representation.
-      # @return [Numo::DFloat] The transformed samples.
+      # @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features])
+      #   The samples to calculate idf and be transformed to tf-idf representation.
+      # @return [Numo::DFloat/Rumale::CSRMatrix] The transformed samples.
       def fit_transform(x, _y = nil)
         fit(x).transform(x)
       end
 
       # Perform transforming the given samples to the tf-idf representation.
       #
-      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be transformed.
-      # @return [Numo::DFloat] The transformed samples.
+      # If the sparse matrix in CSR format is given, the transformation is performed only on the stored elements.
+      #
+      # @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The samples to be transformed.
+      # @return [Numo::DFloat/Rumale::CSRMatrix] The transformed samples.
       def transform(x)
+        return transform_sparse(x) if x.is_a?(Rumale::CSRMatrix)
+
         x = check_convert_sample_array(x)
+        check_idf(x.shape[1])
         z = x.dup
 
         z[z.ne(0)] = Numo::NMath.log(z[z.ne(0)]) + 1 if @params[:sublinear_tf]
         z *= @idf if @params[:use_idf]
         case @params[:norm]
         when 'l2'
-          z = Rumale::Preprocessing::L2Normalizer.new.fit_transform(z)
+          z = Rumale::Preprocessing::L2Normalizer.new(copy: false).fit_transform(z)
         when 'l1'
-          z = Rumale::Preprocessing::L1Normalizer.new.fit_transform(z)
+          z = Rumale::Preprocessing::L1Normalizer.new(copy: false).fit_transform(z)
         end
         z
       end
+
+      private
+
+      def check_idf(n_features)
+        return unless @params[:use_idf]
+        raise 'TfidfTransformer#transform requires the idf values, so the fit method should be called first.' if @idf.nil?
+        raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless n_features == @idf.size
+      end
+
+      def transform_sparse(x)
+        # the idf values are read natively with the column indices of the stored elements.
+        check_idf(x.shape[1])
+        data = x.data.dup
+        csr_tfidf(data, x.indices, x.indptr, @params[:use_idf] ? @idf : nil, @params[:sublinear_tf], @params[:norm])
+        Rumale::CSRMatrix.new(data, x.indices, x.indptr, x.shape)
+      end
     end
   end
 end
@@ -1,17 +1,22 @@
 # frozen_string_literal: true
 
 require 'rumale/validation'
+require 'rumale/utils'
 require 'rumale/base/base_estimator'
 require 'rumale/base/classifier'
 require 'rumale/base/regressor'
 require 'rumale/base/splitter'
 require 'rumale/base/evaluator'
+require 'rumale/evaluation_measure/accuracy'
 require 'rumale/evaluation_measure/log_loss'
+require 'rumale/evaluation_measure/r2_score'
 
 module Rumale
   # This module consists of the classes for model validation techniques.
   module ModelSelection
     # CrossValidation is a class that evaluates a given classifier with cross-validation method.
+    # The dataset is not copied for each split. The estimator is fitted on the views that refer to the rows of the dataset,
+    # or on the dataset itself with the row indices of the split if the supports_sample_indices? method of the estimator returns true.
     #
     # @example
     #   svc = Rumale::LinearModel::SVC.new
@@ -39,21 +44,41 @@ module Rumale
       # @return [Boolean]
       attr_reader :return_train_score
 
+      # Return the flag indicating whether to measure the increase of peak resident set size.
+      # @return [Boolean]
+      attr_reader :measure_memory
+
+      # Return the number of jobs for evaluating the splits in parallel.
+      # @return [Integer]
+      attr_reader :n_jobs
+
       # Create a new evaluator with cross-validation method.
       #
       # @param estimator [Classifier] The classifier of which performance is evaluated.
       # @param splitter [Splitter] The splitter that divides dataset to training and testing dataset.
       # @param evaluator [Evaluator] The evaluator that calculates score of estimator results.
       # @param return_train_score [Boolean] The flag indicating whether to calculate the score of training dataset.
-      def initialize(estimator: nil, splitter: nil, evaluator: nil, return_train_score: false)
+      # @param measure_memory [Boolean] The flag indicating whether to measure the increase of peak resident set size
+      #   while fitting the estimator. The measurement resets the peak resident set size of the whole process on Linux,
+      #   so it affects the callers monitoring the peak memory usage of their own process.
+      # @param n_jobs [Integer] The number of jobs for evaluating the splits in parallel.
+      #   The splits are dispatched to the worker processes in descending order of the number of training samples,
+      #   and the worker processes share the dataset without copying it.
+      #   If nil is given, the splits are evaluated sequentially.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      def initialize(estimator: nil, splitter: nil, evaluator: nil, return_train_score: false, measure_memory: false, n_jobs: nil)
         check_params_type(Rumale::Base::BaseEstimator, estimator: estimator)
         check_params_type(Rumale::Base::Splitter, splitter: splitter)
         check_params_type_or_nil(Rumale::Base::Evaluator, evaluator: evaluator)
-        check_params_boolean(return_train_score: return_train_score)
+        check_params_boolean(return_train_score: return_train_score, measure_memory: measure_memory)
+        check_params_numeric_or_nil(n_jobs: n_jobs)
         @estimator = estimator
         @splitter = splitter
         @evaluator = evaluator
         @return_train_score = return_train_score
+        @measure_memory = measure_memory
+        @n_jobs = n_jobs
       end
 
       # Perform the evalution of given classifier with cross-validation method.
@@ -63,11 +88,40 @@ module Rumale
       # @param y [Numo::Int32 / Numo::DFloat] (shape: [n_samples] / [n_samples, n_outputs])
       #   The labels to be used to evaluate the classifier / The target values to be used to evaluate the regressor.
       # @return [Hash] The report summarizing the results of cross-validation.
-      #   * :fit_time (Array<Float>) The calculation times of fitting the estimator for each split.
+      #   * :fit_time (Array<Float>) The calculation times of fitting the estimator in seconds for each split.
+      #   * :score_time (Array<Float>) The calculation times of scoring the testing dataset in seconds for each split.
+      #   * :peak_rss_delta (Array<Integer>) The increase of peak resident set size in bytes while fitting the estimator
+      #     for each split. The peak is reset to the current resident set size before fitting, so that the value of each split
+      #     is measured from the start of its fitting. The values are nil if the measure_memory is false,
+      #     or if the peak cannot be reset or read on the platform.
+      #   * :allocated_objects (Array<Integer>) The number of objects allocated while fitting the estimator for each split.
       #   * :test_score (Array<Float>) The scores of testing dataset for each split.
       #   * :train_score (Array<Float>) The scores of training dataset for each split. This option is nil if
       #     the return_train_score is false.
       def perform(x, y)
+        x, y = check_dataset(x, y)
+        splits = @splitter.split(x, y)
+        results = if Rumale::Utils.enable_parallel?(@n_jobs)
+                    # Dispatch the splits in descending order of the number of training samples to balance the workers.
+                    order = splits.each_index.sort_by { |n| [-splits[n][0].size, n] }
+                    evaluated = Parallel.map(order, in_processes: Rumale::Utils.n_processes(@n_jobs)) do |n|
+                      evaluate_split(@estimator, x, y, *splits[n])
+                    end
+                    order.zip(evaluated).sort_by(&:first).map(&:last)
+                  else
+                    splits.map { |train_ids, test_ids| evaluate_split(@estimator, x, y, train_ids, test_ids) }
+                  end
+        # Prepare the report of cross validation.
+        report = %i[test_score train_score fit_time score_time peak_rss_delta allocated_objects].map do |key|
+          [key, results.map { |res| res[key] }]
+        end.to_h
+        report[:train_score] = nil unless @return_train_score
+        report
+      end
+
+      # @!visibility private
+      # Check and convert the dataset according to the type of estimator.
+      def check_dataset(x, y)
         x = check_convert_sample_array(x)
         case @estimator
         when Rumale::Base::Classifier
@@ -79,38 +133,113 @@ module Rumale
         else
           y = Numo::NArray.asarray(y)
         end
-        # Initialize the report of cross validation.
-        report = { test_score: [], train_score: nil, fit_time: [] }
-        report[:train_score] = [] if @return_train_score
-        # Evaluate the estimator on each split.
-        @splitter.split(x, y).each do |train_ids, test_ids|
-          # Split dataset into training and testing dataset.
-          feature_ids = !kernel_machine? || train_ids
-          train_x = x[train_ids, feature_ids]
-          train_y = y.shape[1].nil? ? y[train_ids] : y[train_ids, true]
-          test_x = x[test_ids, feature_ids]
-          test_y = y.shape[1].nil? ? y[test_ids] : y[test_ids, true]
-          # Fit the estimator.
-          start_time = Time.now.to_i
-          @estimator.fit(train_x, train_y)
-          # Calculate scores and prepare the report.
-          report[:fit_time].push(Time.now.to_i - start_time)
-          if @evaluator.nil?
-            report[:test_score].push(@estimator.score(test_x, test_y))
-            report[:train_score].push(@estimator.score(train_x, train_y)) if @return_train_score
-          elsif log_loss?
-            report[:test_score].push(@evaluator.score(test_y, @estimator.predict_proba(test_x)))
-            report[:train_score].push(@evaluator.score(train_y, @estimator.predict_proba(train_x))) if @return_train_score
-          else
-            report[:test_score].push(@evaluator.score(test_y, @estimator.predict(test_x)))
-            report[:train_score].push(@evaluator.score(train_y, @estimator.predict(train_x))) if @return_train_score
-          end
+        [x, y]
+      end
+
+      # @!visibility private
+      # Fit the given estimator on the training dataset of the split, and calculate the scores.
+      # The estimator is expected to be the same kind of estimator as the one given to the constructor.
+      def evaluate_split(estimator, x, y, train_ids, test_ids)
+        # The training and testing datasets are the views that refer to the rows of the given dataset,
+        # and the estimator accepting the sample indices is fitted on the given dataset without slicing it.
+        feature_ids = !kernel_machine? || train_ids
+        result = fit_split(estimator, x, y, train_ids, feature_ids)
+        # Calculate scores.
+        start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        result[:test_score] = score_split(estimator, x[test_ids, feature_ids], slice_rows(y, test_ids))
+        result[:score_time] = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time
+        result[:train_score] = @return_train_score ? score_split(estimator, x[train_ids, feature_ids], slice_rows(y, train_ids)) : nil
+        result
+      end
+
+      # @!visibility private
+      # Fit the given ensemble estimator on the training dataset of the split, and calculate the scores
+      # of the ensembles with the given numbers of estimators from the staged predictions.
+      # The fitting and scoring times are shared by the results of all stages.
+      def evaluate_staged_split(estimator, x, y, train_ids, test_ids, stages)
+        result = fit_split(estimator, x, y, train_ids, true)
+        start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        test_scores = staged_scores(estimator, x[test_ids, true], slice_rows(y, test_ids), stages)
+        result[:score_time] = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time
+        train_scores = @return_train_score ? staged_scores(estimator, x[train_ids, true], slice_rows(y, train_ids), stages) : nil
+        stages.each_index.map do |n|
+          result.merge(test_score: test_scores[n], train_score: train_scores.nil? ? nil : train_scores[n])
         end
-        report
       end
 
       private
 
+      def fit_split(estimator, x, y, train_ids, feature_ids)
+        rss_before = @measure_memory ? reset_peak_rss : nil
+        allocated_before = GC.stat(:total_allocated_objects)
+        start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        if fit_with_sample_indices?(estimator)
+          estimator.fit(x, y, sample_indices: train_ids)
+        else
+          estimator.fit(x[train_ids, feature_ids], slice_rows(y, train_ids))
+        end
+        result = { fit_time: Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time,
+                   allocated_objects: GC.stat(:total_allocated_objects) - allocated_before }
+        rss_after = rss_before.nil? ? nil : peak_rss
+        result[:peak_rss_delta] = rss_after.nil? ? nil : rss_after - rss_before
+        result
+      end
+
+      def slice_rows(y, ids)
+        y.shape[1].nil? ? y[ids] : y[ids, true]
+      end
+
+      def fit_with_sample_indices?(estimator)
+        !kernel_machine? && estimator.respond_to?(:supports_sample_indices?) && estimator.supports_sample_indices?
+      end
+
+      def score_split(estimator, x, y)
+        if @evaluator.nil?
+          estimator.score(x, y)
+        elsif log_loss?
+          @evaluator.score(y, estimator.predict_proba(x))
+        else
+          @evaluator.score(y, estimator.predict(x))
+        end
+      end
+
+      def staged_scores(estimator, x, y, stages)
+        # the default evaluators are the same as the score methods of classifier and regressor.
+        evaluator = @evaluator
+        evaluator ||= if estimator.is_a?(Rumale::Base::Classifier)
+                        Rumale::EvaluationMeasure::Accuracy.new
+                      else
+                        Rumale::EvaluationMeasure::R2Score.new
+                      end
+        staged = log_loss? ? estimator.staged_predict_proba(x) : estimator.staged_predict(x)
+        scores = {}
+        last_predicted = nil
+        staged.each_with_index do |predicted, t|
+          scores[t + 1] = evaluator.score(y, predicted) if stages.include?(t + 1)
+          last_predicted = predicted
+        end
+        # the ensemble, such as AdaBoost, may stop adding estimators before reaching the given number of estimators.
+        last_score = nil
+        stages.map { |n| scores.fetch(n) { last_score ||= evaluator.score(y, last_predicted) } }
+      end
+
+      # The peak resident set size of the process is read from procfs, so it is only available on Linux.
+      def peak_rss
+        return nil unless File.readable?(PROC_STATUS_PATH)
+
+        hwm = File.foreach(PROC_STATUS_PATH).find { |line| line.start_with?('VmHWM:') }
+        hwm.nil? ? nil : hwm.split[1].to_i * 1024
+      end
+
+      # The peak is the high-water mark over the lifetime of the process, so it is reset to the current resident set size
+      # by writing 5 to clear_refs. Otherwise, the increase would be zero for every split that does not exceed the earlier peak.
+      def reset_peak_rss
+        File.write(PROC_CLEAR_REFS_PATH, '5')
+        peak_rss
+      rescue SystemCallError, IOError
+        nil
+      end
+
       def kernel_machine?
         class_name = @estimator.class.to_s
         class_name = @estimator.params[:estimator].class.to_s if class_name.include?('Multiclass')
@@ -120,6 +249,10 @@ module Rumale
       def log_loss?
         @evaluator.is_a?(Rumale::EvaluationMeasure::LogLoss)
       end
+
+      PROC_STATUS_PATH = '/proc/self/status'
+      PROC_CLEAR_REFS_PATH = '/proc/self/clear_refs'
+      private_constant :PROC_STATUS_PATH, :PROC_CLEAR_REFS_PATH
     end
   end
 end
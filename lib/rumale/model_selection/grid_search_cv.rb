@@ -4,11 +4,15 @@ require 'rumale/validation'
 require 'rumale/base/base_estimator'
 require 'rumale/base/evaluator'
 require 'rumale/base/splitter'
+require 'rumale/evaluation_measure/log_loss'
 require 'rumale/pipeline/pipeline'
 
 module Rumale
   module ModelSelection
     # GridSearchCV is a class that performs hyperparameter optimization with grid search method.
+    # If the estimator is an ensemble estimator that has the staged_predict method, such as random forest and gradient boosting,
+    # the parameter sets that differ only in n_estimators are evaluated by fitting the estimator once with the largest value
+    # and scoring the staged predictions. The fitting times of these parameter sets are those of the shared fitting.
     #
     # @example
     #   rfc = Rumale::Ensemble::RandomForestClassifier.new(random_seed: 1)
@@ -64,17 +68,30 @@ module Rumale
       #   If nil is given, the score method of estimator is used to evaluation.
       # @param greater_is_better [Boolean] The flag that indicates whether the estimator is better as
       #   evaluation score is larger.
-      def initialize(estimator: nil, param_grid: nil, splitter: nil, evaluator: nil, greater_is_better: true)
+      # @param measure_memory [Boolean] The flag indicating whether to measure the increase of peak resident set size
+      #   in cross validation. It resets the peak resident set size of the whole process on Linux as described in CrossValidation.
+      #   If false is given, the values of max_peak_rss_delta in cv_results are nil.
+      # @param n_jobs [Integer] The number of jobs for running the cross validation in parallel.
+      #   The pairs of parameter set and split are dispatched to the worker processes as independent tasks
+      #   in descending order of their estimated costs, and the worker processes share the dataset without copying it.
+      #   If nil is given, the cross validation is performed sequentially.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      def initialize(estimator: nil, param_grid: nil, splitter: nil, evaluator: nil, greater_is_better: true,
+                     measure_memory: false, n_jobs: nil)
         check_params_type(Rumale::Base::BaseEstimator, estimator: estimator)
         check_params_type(Rumale::Base::Splitter, splitter: splitter)
         check_params_type_or_nil(Rumale::Base::Evaluator, evaluator: evaluator)
-        check_params_boolean(greater_is_better: greater_is_better)
+        check_params_boolean(greater_is_better: greater_is_better, measure_memory: measure_memory)
+        check_params_numeric_or_nil(n_jobs: n_jobs)
         @params = {}
         @params[:param_grid] = valid_param_grid(param_grid)
         @params[:estimator] = Marshal.load(Marshal.dump(estimator))
         @params[:splitter] = Marshal.load(Marshal.dump(splitter))
         @params[:evaluator] = Marshal.load(Marshal.dump(evaluator))
         @params[:greater_is_better] = greater_is_better
+        @params[:measure_memory] = measure_memory
+        @params[:n_jobs] = n_jobs
         @cv_results = nil
         @best_score = nil
         @best_params = nil
@@ -92,12 +109,9 @@ module Rumale
 
         init_attrs
 
-        param_combinations.each do |prm_set|
-          prm_set.each do |prms|
-            report = perform_cross_validation(x, y, prms)
-            store_cv_result(prms, report)
-          end
-        end
+        prm_sets = param_combinations.flatten
+        reports = perform_cross_validation(x, y, prm_sets)
+        prm_sets.zip(reports).each { |prms, report| store_cv_result(prms, report) }
 
         find_best_params
 
@@ -172,11 +186,74 @@ module Rumale
         end
       end
 
-      def perform_cross_validation(x, y, prms)
-        est = configurated_estimator(prms)
-        cv = CrossValidation.new(estimator: est, splitter: @params[:splitter],
-                                 evaluator: @params[:evaluator], return_train_score: true)
-        cv.perform(x, y)
+      def perform_cross_validation(x, y, prm_sets)
+        cv = CrossValidation.new(estimator: @params[:estimator], splitter: @params[:splitter],
+                                 evaluator: @params[:evaluator], return_train_score: true, measure_memory: @params[:measure_memory])
+        x, y = cv.check_dataset(x, y)
+        splits = @params[:splitter].split(x, y)
+        groups = staged_param_groups(prm_sets)
+        # Each pair of group of parameter sets and split is an independent task.
+        # The estimator is configured in each task, or for each group in sequential execution,
+        # so that the fitted estimators are released without being held until the end of the search.
+        results = if enable_parallel?
+                    tasks = Array(0...groups.size).product(Array(0...splits.size))
+                    tasks = tasks.sort_by.with_index { |(g, s), t| [-estimated_cost(prm_sets[groups[g].last], splits[s][0].size), t] }
+                    evaluated = parallel_map(tasks.size) do |t|
+                      g, s = tasks[t]
+                      evaluate_group(cv, configurated_estimator(prm_sets[groups[g].last]), x, y, splits[s], groups[g], prm_sets)
+                    end
+                    tasks.zip(evaluated).sort_by(&:first).map(&:last)
+                  else
+                    groups.flat_map do |group|
+                      estimator = configurated_estimator(prm_sets[group.last])
+                      splits.map { |split| evaluate_group(cv, estimator, x, y, split, group, prm_sets) }
+                    end
+                  end
+        set_results = Array.new(prm_sets.size) { [] }
+        results.each_slice(splits.size).with_index do |group_results, g|
+          group_results.each { |res| groups[g].zip(res).each { |p, r| set_results[p].push(r) } }
+        end
+        set_results.map do |res|
+          %i[test_score train_score fit_time score_time peak_rss_delta allocated_objects].map { |k| [k, res.map { |r| r[k] }] }.to_h
+        end
+      end
+
+      def evaluate_group(cv, estimator, x, y, split, group, prm_sets)
+        return [cv.evaluate_split(estimator, x, y, *split)] if group.size == 1
+
+        cv.evaluate_staged_split(estimator, x, y, *split, group.map { |p| n_estimators_of(prm_sets[p]) })
+      end
+
+      # The parameter sets that differ only in the number of estimators of the ensemble estimator are put together,
+      # so that they are evaluated with the staged predictions of the ensemble with the largest number of estimators.
+      # Each group is sorted in ascending order of the number of estimators.
+      def staged_param_groups(prm_sets)
+        ids = Array(0...prm_sets.size)
+        return ids.map { |p| [p] } unless staged_estimator?
+
+        groups = ids.group_by do |p|
+          n_estimators_of(prm_sets[p]).is_a?(Integer) ? prm_sets[p].reject { |k, _v| k == :n_estimators } : p
+        end
+        groups.values.map { |group| group.sort_by { |p| [n_estimators_of(prm_sets[p]), p] } }
+      end
+
+      def staged_estimator?
+        estimator = @params[:estimator]
+        return false if estimator.is_a?(Rumale::Pipeline::Pipeline)
+        return estimator.respond_to?(:staged_predict_proba) if @params[:evaluator].is_a?(Rumale::EvaluationMeasure::LogLoss)
+
+        estimator.respond_to?(:staged_predict)
+      end
+
+      def n_estimators_of(prms)
+        prms.fetch(:n_estimators) { @params[:estimator].params[:n_estimators] }
+      end
+
+      # The cost of fitting is estimated as the product of the number of training samples and the positive integer
+      # parameters, such as the number of estimators and iterations, for dispatching the expensive tasks first.
+      def estimated_cost(prms, n_train_samples)
+        prms.select { |k, v| v.is_a?(Integer) && v.positive? && !k.to_s.end_with?('random_seed', 'n_jobs') }
+            .values.inject(n_train_samples, :*)
       end
 
       def configurated_estimator(prms)
@@ -195,7 +272,8 @@ module Rumale
       def init_attrs
         @cv_results = %i[mean_test_score std_test_score
                          mean_train_score std_train_score
-                         mean_fit_time std_fit_time params].map { |v| [v, []] }.to_h
+                         mean_fit_time std_fit_time mean_score_time std_score_time
+                         max_peak_rss_delta mean_allocated_objects params].map { |v| [v, []] }.to_h
         @best_score = nil
         @best_params = nil
         @best_index = nil
@@ -206,12 +284,18 @@ module Rumale
         test_scores = Numo::DFloat[*report[:test_score]]
         train_scores = Numo::DFloat[*report[:train_score]]
         fit_times = Numo::DFloat[*report[:fit_time]]
+        score_times = Numo::DFloat[*report[:score_time]]
+        rss_deltas = report[:peak_rss_delta].compact
         @cv_results[:mean_test_score].push(test_scores.mean)
         @cv_results[:std_test_score].push(test_scores.stddev)
         @cv_results[:mean_train_score].push(train_scores.mean)
         @cv_results[:std_train_score].push(train_scores.stddev)
         @cv_results[:mean_fit_time].push(fit_times.mean)
         @cv_results[:std_fit_time].push(fit_times.stddev)
+        @cv_results[:mean_score_time].push(score_times.mean)
+        @cv_results[:std_score_time].push(score_times.stddev)
+        @cv_results[:max_peak_rss_delta].push(rss_deltas.max)
+        @cv_results[:mean_allocated_objects].push(Numo::DFloat[*report[:allocated_objects]].mean)
         @cv_results[:params].push(prms)
       end
 
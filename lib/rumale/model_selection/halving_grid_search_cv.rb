@@ -0,0 +1,232 @@
+# frozen_string_literal: true
+
+require 'rumale/base/classifier'
+require 'rumale/model_selection/grid_search_cv'
+
+module Rumale
+  module ModelSelection
+    # HalvingGridSearchCV is a class that performs hyperparameter optimization with successive halving method.
+    # All parameter sets are first evaluated with a small amount of resource, that is the number of training samples or
+    # the value of an integer parameter such as the number of estimators. Then, only the best 1 / factor of the parameter sets
+    # are evaluated again with factor times as much resource, and this is repeated until the resource reaches the maximum.
+    #
+    # *Reference*
+    # - Jamieson, K., and Talwalkar, A., "Non-stochastic Best Arm Identification and Hyperparameter Optimization," Proc. AISTATS'16, pp. 240--248, 2016.
+    #
+    # @example
+    #   rfc = Rumale::Ensemble::RandomForestClassifier.new(random_seed: 1)
+    #   pg = { max_depth: [3, 5, 7, nil], max_features: [1, 2, 4] }
+    #   kf = Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5)
+    #   hs = Rumale::ModelSelection::HalvingGridSearchCV.new(estimator: rfc, param_grid: pg, splitter: kf,
+    #                                                        resource: :n_estimators, max_resources: 90, random_seed: 1)
+    #   hs.fit(samples, labels)
+    #   p hs.n_resources
+    #   p hs.n_candidates
+    #   p hs.best_params
+    #
+    class HalvingGridSearchCV < GridSearchCV
+      # Return the number of iterations of successive halving.
+      # @return [Integer]
+      attr_reader :n_iterations
+
+      # Return the amount of resource used at each iteration.
+      # @return [Array<Integer>]
+      attr_reader :n_resources
+
+      # Return the number of parameter sets evaluated at each iteration.
+      # @return [Array<Integer>]
+      attr_reader :n_candidates
+
+      # Create a new grid search method with successive halving.
+      #
+      # @param estimator [Classifier/Regresor] The estimator to be searched for optimal parameters.
+      # @param param_grid [Array<Hash>] The parameter sets is represented with array of hash that
+      #   consists of parameter names as keys and array of parameter values as values.
+      # @param splitter [Splitter] The splitter that divides dataset to training and testing dataset on cross validation.
+      # @param evaluator [Evaluator] The evaluator that calculates score of estimator results on cross validation.
+      #   If nil is given, the score method of estimator is used to evaluation.
+      # @param greater_is_better [Boolean] The flag that indicates whether the estimator is better as
+      #   evaluation score is larger.
+      # @param factor [Integer] The rate of reducing the parameter sets and increasing the resource at each iteration.
+      # @param resource [Symbol] The resource increased at each iteration. If :n_samples is given, the number of samples
+      #   randomly drawn from the training data is used as the resource. Otherwise, the resource is the value of
+      #   the given integer parameter of the estimator (e.g. :n_estimators, :max_iter, or :svc__max_iter for pipeline).
+      # @param min_resources [Integer] The amount of resource used at the first iteration. If nil is given,
+      #   it is determined so that the last iteration uses as much resource as possible.
+      # @param max_resources [Integer] The maximum amount of resource. If nil is given, it becomes the number of samples
+      #   for :n_samples, or the value of the parameter of the given estimator for the other resources.
+      # @param measure_memory [Boolean] The flag indicating whether to measure the increase of peak resident set size
+      #   in cross validation. It resets the peak resident set size of the whole process on Linux as described in CrossValidation.
+      #   If false is given, the values of max_peak_rss_delta in cv_results are nil.
+      # @param n_jobs [Integer] The number of jobs for running the cross validation at each iteration in parallel.
+      #   If nil is given, the cross validation is performed sequentially.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      # @param random_seed [Integer] The seed value using to initialize the random generator for drawing samples.
+      def initialize(estimator: nil, param_grid: nil, splitter: nil, evaluator: nil, greater_is_better: true,
+                     factor: 3, resource: :n_samples, min_resources: nil, max_resources: nil, measure_memory: false,
+                     n_jobs: nil, random_seed: nil)
+        super(estimator: estimator, param_grid: param_grid, splitter: splitter, evaluator: evaluator,
+              greater_is_better: greater_is_better, measure_memory: measure_memory, n_jobs: n_jobs)
+        check_params_numeric(factor: factor)
+        check_params_numeric_or_nil(min_resources: min_resources, max_resources: max_resources, random_seed: random_seed)
+        raise ArgumentError, 'Expect factor to be an integer greater than 1' unless factor.is_a?(Integer) && factor > 1
+        check_params_positive(min_resources: min_resources, max_resources: max_resources)
+        if [min_resources, max_resources].compact.any?(&:zero?)
+          raise ArgumentError, 'Expect min_resources and max_resources to be greater than 0'
+        end
+
+        @params[:factor] = factor
+        @params[:resource] = resource.to_sym
+        @params[:min_resources] = min_resources
+        @params[:max_resources] = max_resources
+        @params[:random_seed] = random_seed
+        @params[:random_seed] ||= srand
+        @rng = Random.new(@params[:random_seed])
+        @n_iterations = nil
+        @n_resources = nil
+        @n_candidates = nil
+      end
+
+      # Fit the model with given training data by evaluating the parameter sets with successive halving.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The training data to be used for fitting the model.
+      # @param y [Numo::NArray] (shape: [n_samples, n_outputs]) The target values or labels to be used for fitting the model.
+      # @return [HalvingGridSearchCV] The learned estimator with successive halving.
+      def fit(x, y)
+        x = check_convert_sample_array(x)
+        y = Numo::NArray.asarray(y)
+
+        init_attrs
+
+        max_res = max_resources(x)
+        candidates = candidate_param_sets(y, max_res)
+        min_res = min_resources(y, candidates.size, max_res)
+        @n_iterations = [n_halvings(candidates.size, 1), n_halvings(max_res, min_res)].min + 1
+        sample_ids = resource_sample_order(y)
+
+        @n_iterations.times do |iter|
+          n_res = [min_res * @params[:factor]**iter, max_res].min
+          prm_sets = candidates.map { |prms| resource_param_set(prms, n_res) }
+          sub_x, sub_y = resource_dataset(x, y, sample_ids, n_res)
+          reports = perform_cross_validation(sub_x, sub_y, prm_sets)
+          prm_sets.zip(reports).each do |prms, report|
+            store_cv_result(prms, report)
+            @cv_results[:iter].push(iter)
+            @cv_results[:n_resources].push(n_res)
+          end
+          @n_resources.push(n_res)
+          @n_candidates.push(candidates.size)
+          candidates = survived_param_sets(candidates, reports) if iter < @n_iterations - 1
+        end
+
+        find_best_params
+
+        @best_estimator = configurated_estimator(@best_params)
+        @best_estimator.fit(x, y)
+        self
+      end
+
+      private
+
+      def candidate_param_sets(_y, _max_res)
+        param_combinations.flatten
+      end
+
+      def sample_resource?
+        @params[:resource] == :n_samples
+      end
+
+      def max_resources(x)
+        return @params[:max_resources] || x.shape[0] if sample_resource?
+        return @params[:max_resources] unless @params[:max_resources].nil?
+
+        estimator = @params[:estimator]
+        n_res = if estimator.is_a?(Rumale::Pipeline::Pipeline)
+                  est_name, prm_name = @params[:resource].to_s.split('__')
+                  estimator.steps[est_name.to_sym].params[prm_name.to_sym]
+                else
+                  estimator.params[@params[:resource]]
+                end
+        raise ArgumentError, "Expect the estimator to have the integer parameter #{@params[:resource]}" unless n_res.is_a?(Integer)
+
+        n_res
+      end
+
+      def min_resources(y, n_candidates, max_res)
+        return @params[:min_resources] unless @params[:min_resources].nil?
+
+        # use as much resource as possible at the last iteration.
+        [[max_res / @params[:factor]**n_halvings(n_candidates, 1), lower_resources(y)].max, max_res].min
+      end
+
+      # The training dataset of each split should have a few samples of each class at least.
+      def lower_resources(y)
+        return 1 unless sample_resource?
+
+        lower = 2 * (@params[:splitter].n_splits || 1)
+        lower *= y.to_a.uniq.size if @params[:estimator].is_a?(Rumale::Base::Classifier)
+        lower
+      end
+
+      def n_halvings(n, lower)
+        count = 0
+        while n >= lower * @params[:factor]
+          n /= @params[:factor]
+          count += 1
+        end
+        count
+      end
+
+      def resource_param_set(prms, n_res)
+        sample_resource? ? prms : prms.merge(@params[:resource] => n_res)
+      end
+
+      def resource_sample_order(y)
+        return nil unless sample_resource?
+
+        order = Array(0...y.shape[0]).shuffle(random: @rng.dup)
+        return order unless @params[:estimator].is_a?(Rumale::Base::Classifier)
+
+        # arrange the samples so that every prefix of the order has nearly the same ratio of classes as the whole dataset.
+        labels = y.to_a
+        counts = Hash.new(0)
+        labels.each { |l| counts[l] += 1 }
+        ranks = Hash.new(0)
+        keys = order.map { |i| (ranks[labels[i]] += 1).fdiv(counts[labels[i]]) }
+        Array(0...order.size).sort_by { |n| [keys[n], n] }.map { |n| order[n] }
+      end
+
+      def resource_dataset(x, y, sample_ids, n_res)
+        return [x, y] if !sample_resource? || n_res >= x.shape[0]
+
+        ids = sample_ids[0...n_res]
+        [x[ids, true], y.shape[1].nil? ? y[ids] : y[ids, true]]
+      end
+
+      def survived_param_sets(candidates, reports)
+        scores = reports.map { |report| Numo::DFloat[*report[:test_score]].mean }
+        ranking = Array(0...candidates.size).sort_by { |n| [@params[:greater_is_better] ? -scores[n] : scores[n], n] }
+        n_survived = candidates.size.fdiv(@params[:factor]).ceil
+        ranking.first(n_survived).sort.map { |n| candidates[n] }
+      end
+
+      def init_attrs
+        super
+        @cv_results[:iter] = []
+        @cv_results[:n_resources] = []
+        @n_iterations = nil
+        @n_resources = []
+        @n_candidates = []
+      end
+
+      def find_best_params
+        last_ids = @cv_results[:iter].each_index.select { |n| @cv_results[:iter][n] == @n_iterations - 1 }
+        scores = last_ids.map { |n| @cv_results[:mean_test_score][n] }
+        @best_score = @params[:greater_is_better] ? scores.max : scores.min
+        @best_index = last_ids[scores.index(@best_score)]
+        @best_params = @cv_results[:params][@best_index]
+      end
+    end
+  end
+end
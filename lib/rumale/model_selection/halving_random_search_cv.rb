@@ -0,0 +1,75 @@
+# frozen_string_literal: true
+
+require 'rumale/model_selection/halving_grid_search_cv'
+require 'rumale/model_selection/param_sampler'
+
+module Rumale
+  module ModelSelection
+    # HalvingRandomSearchCV is a class that performs hyperparameter optimization with successive halving method
+    # on the parameter sets randomly drawn from the given lists, ranges, or distributions of parameter values.
+    #
+    # @example
+    #   rfc = Rumale::Ensemble::RandomForestClassifier.new(random_seed: 1)
+    #   pd = { max_depth: [3, 5, 7, nil], max_features: 1..4, min_samples_leaf: [1, 2, 4] }
+    #   kf = Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5)
+    #   hs = Rumale::ModelSelection::HalvingRandomSearchCV.new(estimator: rfc, param_distributions: pd, splitter: kf,
+    #                                                          n_candidates: 27, random_seed: 1)
+    #   hs.fit(samples, labels)
+    #   p hs.best_params
+    #
+    class HalvingRandomSearchCV < HalvingGridSearchCV
+      include ParamSampler
+
+      # Create a new random search method with successive halving.
+      #
+      # @param estimator [Classifier/Regresor] The estimator to be searched for optimal parameters.
+      # @param param_distributions [Hash] The hash consisting of parameter names as keys and
+      #   the array of parameter values, range of parameter values, or Proc that draws a value with the given
+      #   random generator as values. The value is drawn uniformly from the array or range for each parameter set.
+      # @param n_candidates [Integer] The number of parameter sets drawn at the first iteration.
+      #   If nil is given, it is determined so that the last iteration uses the maximum resource.
+      # @param splitter [Splitter] The splitter that divides dataset to training and testing dataset on cross validation.
+      # @param evaluator [Evaluator] The evaluator that calculates score of estimator results on cross validation.
+      #   If nil is given, the score method of estimator is used to evaluation.
+      # @param greater_is_better [Boolean] The flag that indicates whether the estimator is better as
+      #   evaluation score is larger.
+      # @param factor [Integer] The rate of reducing the parameter sets and increasing the resource at each iteration.
+      # @param resource [Symbol] The resource increased at each iteration (:n_samples or the name of integer parameter).
+      # @param min_resources [Integer] The amount of resource used at the first iteration. If nil is given,
+      #   it becomes the smallest amount that each split of cross validation can be performed.
+      # @param max_resources [Integer] The maximum amount of resource. If nil is given, it becomes the number of samples
+      #   for :n_samples, or the value of the parameter of the given estimator for the other resources.
+      # @param measure_memory [Boolean] The flag indicating whether to measure the increase of peak resident set size
+      #   in cross validation. It resets the peak resident set size of the whole process on Linux as described in CrossValidation.
+      #   If false is given, the values of max_peak_rss_delta in cv_results are nil.
+      # @param n_jobs [Integer] The number of jobs for running the cross validation at each iteration in parallel.
+      #   If nil is given, the cross validation is performed sequentially.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      # @param random_seed [Integer] The seed value using to initialize the random generator
+      #   for drawing parameter sets and samples.
+      def initialize(estimator: nil, param_distributions: nil, n_candidates: nil, splitter: nil, evaluator: nil,
+                     greater_is_better: true, factor: 3, resource: :n_samples, min_resources: nil, max_resources: nil,
+                     measure_memory: false, n_jobs: nil, random_seed: nil)
+        super(estimator: estimator, param_grid: param_distributions, splitter: splitter, evaluator: evaluator,
+              greater_is_better: greater_is_better, factor: factor, resource: resource, min_resources: min_resources,
+              max_resources: max_resources, measure_memory: measure_memory, n_jobs: n_jobs, random_seed: random_seed)
+        check_params_numeric_or_nil(n_candidates: n_candidates)
+        @params[:param_distributions] = @params.delete(:param_grid).first
+        @params[:n_candidates] = n_candidates
+      end
+
+      private
+
+      def candidate_param_sets(y, max_res)
+        n_candidates = @params[:n_candidates]
+        n_candidates ||= @params[:factor]**n_halvings(max_res, @params[:min_resources] || lower_resources(y))
+        sample_param_sets(n_candidates, @rng.dup)
+      end
+
+      def min_resources(y, _n_candidates, max_res)
+        @params[:min_resources] || [lower_resources(y), max_res].min
+      end
+    end
+  end
+end
@@ -0,0 +1,58 @@
+# frozen_string_literal: true
+
+module Rumale
+  module ModelSelection
+    # @!visibility private
+    # Module for drawing parameter sets randomly from the lists, ranges, or distributions of parameter values.
+    module ParamSampler
+      # @!visibility private
+      # The distributions given as Proc cannot be dumped with Marshal module, so they are replaced with
+      # the arrays of values drawn from them in the search. The distributions with no drawn values are omitted.
+      def marshal_dump
+        vars = instance_variables.each_with_object({}) { |name, obj| obj[name] = instance_variable_get(name) }
+        drawn = @cv_results.nil? ? [] : @cv_results[:params]
+        distributions = @params[:param_distributions].each_with_object({}) do |(name, dist), obj|
+          if !dist.respond_to?(:call)
+            obj[name] = dist
+          elsif drawn.any? { |prms| prms.key?(name) }
+            obj[name] = drawn.map { |prms| prms[name] }.uniq
+          end
+        end
+        vars[:@params] = @params.merge(param_distributions: distributions)
+        vars
+      end
+
+      # @!visibility private
+      def marshal_load(vars)
+        vars.each { |name, val| instance_variable_set(name, val) }
+      end
+
+      private
+
+      def valid_param_grid(distributions)
+        raise TypeError, 'Expect class of param_distributions to be Hash' unless distributions.is_a?(Hash)
+        unless distributions.values.all? { |v| v.is_a?(Array) || v.is_a?(Range) || v.respond_to?(:call) }
+          raise TypeError, 'Expect class of parameter values in param_distributions to be Array, Range, or Proc'
+        end
+
+        [distributions]
+      end
+
+      def sample_param_sets(n_sets, rng)
+        distributions = @params[:param_distributions].sort
+        Array.new(n_sets) { distributions.map { |name, dist| [name, sample_param_value(dist, rng)] }.to_h }
+      end
+
+      def sample_param_value(dist, rng)
+        case dist
+        when Array
+          dist[rng.rand(dist.size)]
+        when Range
+          rng.rand(dist)
+        else
+          dist.call(rng)
+        end
+      end
+    end
+  end
+end
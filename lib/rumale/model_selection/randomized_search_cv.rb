@@ -0,0 +1,98 @@
+# frozen_string_literal: true
+
+require 'rumale/model_selection/grid_search_cv'
+require 'rumale/model_selection/param_sampler'
+
+module Rumale
+  module ModelSelection
+    # RandomizedSearchCV is a class that performs hyperparameter optimization with random search method.
+    # Instead of evaluating all combinations of parameter values, it evaluates the fixed number of parameter sets
+    # randomly drawn from the lists, ranges, or distributions of parameter values,
+    # so that the cost of search does not depend on the number of parameters.
+    #
+    # *Reference*
+    # - Bergstra, J., and Bengio, Y., "Random Search for Hyper-Parameter Optimization," J. Machine Learning Research, vol. 13, pp. 281--305, 2012.
+    #
+    # @example
+    #   gbc = Rumale::Ensemble::GradientBoostingClassifier.new(random_seed: 1)
+    #   pd = {
+    #     learning_rate: ->(rng) { 10**rng.rand(-3.0..0.0) },
+    #     max_depth: 2..8, max_features: [nil, 2, 4], subsample: 0.5..1.0, reg_lambda: [0.0, 0.1, 1.0]
+    #   }
+    #   kf = Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5)
+    #   rs = Rumale::ModelSelection::RandomizedSearchCV.new(estimator: gbc, param_distributions: pd, splitter: kf,
+    #                                                       n_iter: 50, max_time: 600, n_jobs: -1, random_seed: 1)
+    #   rs.fit(samples, labels)
+    #   p rs.best_params
+    #
+    class RandomizedSearchCV < GridSearchCV
+      include ParamSampler
+
+      # Create a new random search method.
+      #
+      # @param estimator [Classifier/Regresor] The estimator to be searched for optimal parameters with random search method.
+      # @param param_distributions [Hash] The hash consisting of parameter names as keys and
+      #   the array of parameter values, range of parameter values, or Proc that draws a value with the given
+      #   random generator as values. The value is drawn uniformly from the array or range for each parameter set.
+      # @param n_iter [Integer] The number of parameter sets to be drawn and evaluated.
+      # @param splitter [Splitter] The splitter that divides dataset to training and testing dataset on cross validation.
+      # @param evaluator [Evaluator] The evaluator that calculates score of estimator results on cross validation.
+      #   If nil is given, the score method of estimator is used to evaluation.
+      # @param greater_is_better [Boolean] The flag that indicates whether the estimator is better as
+      #   evaluation score is larger.
+      # @param max_time [Float] The budget of wall-clock time for the search in seconds.
+      #   If the elapsed time exceeds the budget, the parameter sets that have not been evaluated yet are skipped.
+      #   The parameter sets being evaluated are not interrupted, so the search may take a little longer than the budget.
+      #   If nil is given, all parameter sets are evaluated.
+      # @param measure_memory [Boolean] The flag indicating whether to measure the increase of peak resident set size
+      #   in cross validation. It resets the peak resident set size of the whole process on Linux as described in CrossValidation.
+      #   If false is given, the values of max_peak_rss_delta in cv_results are nil.
+      # @param n_jobs [Integer] The number of jobs for running the cross validation in parallel.
+      #   If nil is given, the cross validation is performed sequentially.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      # @param random_seed [Integer] The seed value using to initialize the random generator for drawing parameter sets.
+      def initialize(estimator: nil, param_distributions: nil, n_iter: 10, splitter: nil, evaluator: nil, greater_is_better: true,
+                     max_time: nil, measure_memory: false, n_jobs: nil, random_seed: nil)
+        super(estimator: estimator, param_grid: param_distributions, splitter: splitter, evaluator: evaluator,
+              greater_is_better: greater_is_better, measure_memory: measure_memory, n_jobs: n_jobs)
+        check_params_numeric(n_iter: n_iter)
+        check_params_numeric_or_nil(max_time: max_time, random_seed: random_seed)
+        check_params_positive(n_iter: n_iter)
+        @params[:param_distributions] = @params.delete(:param_grid).first
+        @params[:n_iter] = n_iter
+        @params[:max_time] = max_time
+        @params[:random_seed] = random_seed
+        @params[:random_seed] ||= srand
+        @rng = Random.new(@params[:random_seed])
+      end
+
+      # Fit the model with given training data and the parameter sets drawn randomly.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The training data to be used for fitting the model.
+      # @param y [Numo::NArray] (shape: [n_samples, n_outputs]) The target values or labels to be used for fitting the model.
+      # @return [RandomizedSearchCV] The learned estimator with random search.
+      def fit(x, y)
+        x = check_convert_sample_array(x)
+
+        init_attrs
+
+        prm_sets = sample_param_sets(@params[:n_iter], @rng.dup)
+        # the parameter sets are evaluated in batches as large as the number of workers to check the budget between them.
+        batch_size = @params[:max_time].nil? ? prm_sets.size : n_processes
+        start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        prm_sets.each_slice(batch_size) do |batch|
+          reports = perform_cross_validation(x, y, batch)
+          batch.zip(reports).each { |prms, report| store_cv_result(prms, report) }
+          break if !@params[:max_time].nil? && Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time >= @params[:max_time]
+        end
+
+        find_best_params
+
+        @best_estimator = configurated_estimator(@best_params)
+        @best_estimator.fit(x, y)
+        self
+      end
+    end
+  end
+end
@@ -14,6 +14,7 @@ module Rumale
       # - Kingma, D P., and Ba, J., "Adam: A Method for Stochastic Optimization," Proc. ICLR'15, 2015.
       class Adam
         include Base::BaseEstimator
+        include ExtAdam
 
         # @!visibility private
         # Create a new optimizer with Adam
@@ -50,6 +51,24 @@ module Rumale
 
           weight - @params[:learning_rate] * nm_fst_moment / (nm_sec_moment**0.5 + 1e-8)
         end
+
+        # @!visibility private
+        # Update the given weight with Adam adaptive learning rate in place.
+        # Unlike the call method, this method does not allocate new arrays except for the moments on the first call.
+        #
+        # @param weight [Numo::DFloat] (shape: [n_features]) The weight to be updated.
+        # @param gradient [Numo::DFloat] (shape: [n_features]) The gradient for updating the weight.
+        # @return [Numo::DFloat] (shape: [n_feautres]) The updated weight.
+        def update(weight, gradient)
+          @fst_moment ||= Numo::DFloat.zeros(weight.shape)
+          @sec_moment ||= Numo::DFloat.zeros(weight.shape)
+
+          @iter += 1
+
+          adam_update(weight, gradient, @fst_moment, @sec_moment,
+                      @params[:learning_rate], @params[:decay1], @params[:decay2], @iter)
+          weight
+        end
       end
     end
   end
@@ -1,5 +1,6 @@
 # frozen_string_literal: true
 
+require 'etc'
 require 'rumale/base/base_estimator'
 
 module Rumale
@@ -76,6 +77,83 @@ module Rumale
           [out, backward]
         end
       end
+
+      # @!visibility private
+      # FusedAffine is a class that calculates the linear transform followed by rectified linear function and dropout
+      # with the native extension. The output values and gradients are written into the buffers preallocated
+      # for each batch size, and the weight and bias are updated in place.
+      # This class is used internally.
+      class FusedAffine
+        include ExtFusedAffine
+
+        # @!visibility private
+        attr_reader :weight, :bias
+
+        # @!visibility private
+        def initialize(n_inputs: nil, n_outputs: nil, relu: false, dropout_rate: 0.0, optimizer: nil, rng: nil, n_threads: 1)
+          rng ||= Random.new
+          @weight = 0.01 * Rumale::Utils.rand_normal([n_inputs, n_outputs], rng, n_jobs: n_threads)
+          @bias = Numo::DFloat.zeros(n_outputs)
+          @grad_weight = Numo::DFloat.zeros(n_inputs, n_outputs)
+          @grad_bias = Numo::DFloat.zeros(n_outputs)
+          @optimizer_weight = optimizer.dup
+          @optimizer_bias = optimizer.dup
+          @relu = relu
+          @dropout_rate = dropout_rate
+          @rng_state = Numo::UInt64.cast(Array.new(4) { rng.rand(1..Rumale::Values.int_max) })
+          @n_threads = n_threads
+          @buffers = {}
+          @input = nil
+        end
+
+        # @!visibility private
+        def forward(x)
+          buf = buffers(x.shape[0])
+          fused_affine_forward(x, @weight, @bias, buf[:out], buf[:mask], @relu, @dropout_rate, @rng_state, @n_threads)
+          @input = x
+          buf[:out]
+        end
+
+        # @!visibility private
+        def backward(dout, propagate)
+          buf = buffers(dout.shape[0])
+          buf[:dx] ||= Numo::DFloat.zeros(*@input.shape) if propagate
+          dx = propagate ? buf[:dx] : nil
+          fused_affine_backward(@input, buf[:out], dout, @weight, @grad_weight, @grad_bias, buf[:mask], dx, @relu, @n_threads)
+          @optimizer_weight.update(@weight, @grad_weight)
+          @optimizer_bias.update(@bias, @grad_bias)
+          dx
+        end
+
+        # @!visibility private
+        def predict(x)
+          out = Numo::DFloat.zeros(x.shape[0], @bias.size)
+          fused_affine_forward(x, @weight, @bias, out, nil, @relu, 0.0, @rng_state, @n_threads)
+          out
+        end
+
+        # @!visibility private
+        def delete_dropout
+          @dropout_rate = 0.0
+          release_buffers
+        end
+
+        # @!visibility private
+        def release_buffers
+          @buffers = {}
+          @input = nil
+          self
+        end
+
+        private
+
+        def buffers(n_samples)
+          @buffers[n_samples] ||= {
+            out: Numo::DFloat.zeros(n_samples, @bias.size),
+            mask: @dropout_rate.positive? ? Numo::DFloat.zeros(n_samples, @bias.size) : nil
+          }
+        end
+      end
     end
 
     # @!visibility private
@@ -85,6 +163,8 @@ module Rumale
       # MeanSquaredError is a class that calculates mean squared error for regression task.
       # This class is used internally.
       class MeanSquaredError
+        include ExtMeanSquaredError
+
         # @!visibility private
         def call(out, y)
           sz_batch = y.shape[0]
@@ -93,12 +173,19 @@ module Rumale
           dout = 2.fdiv(sz_batch) * diff
           [loss, dout]
         end
+
+        # @!visibility private
+        def fused_call(out, y, dout)
+          mean_squared_error(out, y, dout)
+        end
       end
 
       # @!visibility private
       # SoftmaxCrossEntropy is a class that calculates softmax cross-entropy for classification task.
       # This class is used internally.
       class SoftmaxCrossEntropy
+        include ExtSoftmaxCrossEntropy
+
         # @!visibility private
         def call(out, y)
           sz_batch = y.shape[0]
@@ -108,6 +195,11 @@ module Rumale
           [loss, dout]
         end
 
+        # @!visibility private
+        def fused_call(out, y, dout)
+          softmax_cross_entropy(out, y, dout)
+        end
+
         private
 
         def softmax(x)
@@ -163,12 +255,113 @@ module Rumale
           [out, backward]
         end
       end
+
+      # @!visibility private
+      # FusedSequential is a class that implements linear stack model consisting of FusedAffine layers.
+      # The training pass does not create closures and reuses the buffers of each layer.
+      # This class is used internally.
+      class FusedSequential
+        # @!visibility private
+        attr_reader :layers
+
+        # @!visibility private
+        def initialize
+          @layers = []
+          @dout_buffers = {}
+          @dout = nil
+        end
+
+        # @!visibility private
+        def push(ops)
+          @layers.push(ops)
+          self
+        end
+
+        # @!visibility private
+        def delete_dropout
+          @layers.each(&:delete_dropout)
+          self
+        end
+
+        # @!visibility private
+        def forward(x)
+          out = x
+          @layers.each { |l| out = l.forward(out) }
+          out
+        end
+
+        # @!visibility private
+        def forward_loss(x, y, loss_func)
+          out = forward(x)
+          @dout = (@dout_buffers[y.shape[0]] ||= Numo::DFloat.zeros(*y.shape))
+          loss_func.fused_call(out, y, @dout)
+        end
+
+        # @!visibility private
+        def backward
+          dout = @dout
+          (@layers.size - 1).downto(0) { |n| dout = @layers[n].backward(dout, n.positive?) }
+          nil
+        end
+
+        # @!visibility private
+        def predict(x)
+          out = x
+          @layers.each { |l| out = l.predict(out) }
+          out
+        end
+
+        # @!visibility private
+        def release_buffers
+          @layers.each(&:release_buffers)
+          @dout_buffers = {}
+          @dout = nil
+          self
+        end
+
+        # @!visibility private
+        def compile(n_threads: 1)
+          CompiledNetwork.new(@layers, n_threads: n_threads)
+        end
+      end
+
+      # @!visibility private
+      # CompiledNetwork is a class that implements frozen inference-only network exported from FusedSequential.
+      # The weights and biases of all layers are stored in contiguous single-precision buffers,
+      # and the forward pass through all layers is performed with a single call of the native extension.
+      # This class is used internally.
+      class CompiledNetwork
+        include ExtCompiledNetwork
+
+        # @!visibility private
+        attr_reader :layer_sizes, :weights, :biases
+
+        # @!visibility private
+        def initialize(layers, n_threads: 1)
+          @layer_sizes = Numo::Int32[layers.first.weight.shape[0], *layers.map { |l| l.bias.size }].freeze
+          @weights = Numo::SFloat.cast(Numo::DFloat.concatenate(layers.map { |l| l.weight.flatten })).freeze
+          @biases = Numo::SFloat.cast(Numo::DFloat.concatenate(layers.map(&:bias))).freeze
+          @n_threads = n_threads
+          freeze
+        end
+
+        # @!visibility private
+        def predict(x)
+          x = Numo::DFloat.cast(x) unless x.is_a?(Numo::DFloat)
+          return predict(x.expand_dims(0))[0, true] if x.ndim == 1
+
+          out = Numo::DFloat.zeros(x.shape[0], @layer_sizes[-1])
+          compiled_forward(x, @weights, @biases, @layer_sizes, out, @n_threads)
+          out
+        end
+      end
     end
 
     # BaseMLP is an abstract class for implementation of multi-layer peceptron estimator.
     # This class is used internally.
     class BaseMLP
       include Base::BaseEstimator
+      include ExtBaseMLP
 
       # Create a multi-layer perceptron estimator.
       #
@@ -182,9 +375,12 @@ module Rumale
       # @param batch_size [Intger] The size of the mini batches.
       # @param tol [Float] The tolerance of loss for terminating optimization.
       # @param verbose [Boolean] The flag indicating whether to output loss during iteration.
+      # @param n_jobs [Integer] The number of threads for matrix multiplication in the native extension.
+      #   If nil is given, the calculation runs on a single thread.
+      #   If zero or less is given, it becomes equal to the number of processors.
       # @param random_seed [Integer] The seed value using to initialize the random generator.
       def initialize(hidden_units: [128, 128], dropout_rate: 0.4, learning_rate: 0.001, decay1: 0.9, decay2: 0.999,
-                     max_iter: 200, batch_size: 50, tol: 1e-4, verbose: false, random_seed: nil)
+                     max_iter: 200, batch_size: 50, tol: 1e-4, verbose: false, n_jobs: nil, random_seed: nil)
         @params = {}
         @params[:hidden_units] = hidden_units
         @params[:dropout_rate] = dropout_rate
@@ -195,53 +391,85 @@ module Rumale
         @params[:batch_size] = batch_size
         @params[:tol] = tol
         @params[:verbose] = verbose
+        @params[:n_jobs] = n_jobs
         @params[:random_seed] = random_seed
         @params[:random_seed] ||= srand
         @n_iter = nil
+        @compiled_network = nil
         @rng = Random.new(@params[:random_seed])
       end
 
+      # Export the learned network to a frozen inference-only network that holds the weights in single precision,
+      # and use it for prediction after this. The compiled network performs the forward pass through all layers
+      # with a single call of the native extension, so it reduces the latency of prediction especially for small batches.
+      # Calling the fit method discards the compiled network.
+      #
+      # @return [BaseMLP] The estimator itself.
+      def compile
+        @compiled_network = @network.compile(n_threads: n_threads)
+        self
+      end
+
       private
 
+      def predict_network(x)
+        @compiled_network.nil? ? @network.predict(x) : @compiled_network.predict(x)
+      end
+
       def buld_network(n_inputs, n_outputs, srng = nil)
         adam = Rumale::NeuralNetwork::Optimizer::Adam.new(
           learning_rate: @params[:learning_rate], decay1: @params[:decay1], decay2: @params[:decay2]
         )
-        model = Model::Sequential.new
+        model = Model::FusedSequential.new
         n_units = [n_inputs, *@params[:hidden_units]]
         n_units.each_cons(2) do |n_in, n_out|
-          model.push(Layer::Affine.new(n_inputs: n_in, n_outputs: n_out, optimizer: adam, rng: srng))
-          model.push(Layer::Relu.new)
-          model.push(Layer::Dropout.new(rate: @params[:dropout_rate], rng: srng))
+          model.push(Layer::FusedAffine.new(n_inputs: n_in, n_outputs: n_out, relu: true, dropout_rate: @params[:dropout_rate],
+                                            optimizer: adam, rng: srng, n_threads: n_threads))
         end
-        model.push(Layer::Affine.new(n_inputs: n_units[-1], n_outputs: n_outputs, optimizer: adam, rng: srng))
+        model.push(Layer::FusedAffine.new(n_inputs: n_units[-1], n_outputs: n_outputs, optimizer: adam, rng: srng,
+                                          n_threads: n_threads))
       end
 
       def train(x, y, network, loss_func, srng = nil)
         class_name = self.class.to_s.split('::').last
-        n_samples = x.shape[0]
+        n_samples, n_features = x.shape
+        y = Numo::DFloat.cast(y)
+        n_outputs = y.shape[1]
+        srng ||= Random.new
+        rng_state = Numo::UInt64.cast(Array.new(4) { srng.rand(1..Rumale::Values.int_max) })
+        sample_ids = Numo::Int32.new(n_samples).seq
+        batch_x = {}
+        batch_y = {}
 
         @params[:max_iter].times do |t|
-          sample_ids = Array(0...n_samples)
-          sample_ids.shuffle!(random: srng)
-          until (subset_ids = sample_ids.shift(@params[:batch_size])).empty?
+          shuffle_ids(sample_ids, rng_state)
+          offset = 0
+          while offset < n_samples
             # random sampling
-            sub_x = x[subset_ids, true].dup
-            sub_y = y[subset_ids, true].dup
-            # forward
-            out, backward = network.forward(sub_x)
-            # calc loss function
-            loss, dout = loss_func.call(out, sub_y)
+            n_rows = [@params[:batch_size], n_samples - offset].min
+            sub_x = (batch_x[n_rows] ||= Numo::DFloat.zeros(n_rows, n_features))
+            sub_y = (batch_y[n_rows] ||= Numo::DFloat.zeros(n_rows, n_outputs))
+            gather_rows(x, sample_ids, offset, sub_x)
+            gather_rows(y, sample_ids, offset, sub_y)
+            offset += n_rows
+            # forward and calc loss function
+            loss = network.forward_loss(sub_x, sub_y, loss_func)
             break if loss < @params[:tol]
 
             # backward
-            backward.call(dout)
+            network.backward
           end
           @n_iter = t + 1
           puts "[#{class_name}] Loss after #{@n_iter} epochs: #{loss}" if @params[:verbose]
         end
 
-        network
+        network.release_buffers
+      end
+
+      def n_threads
+        return 1 if @params[:n_jobs].nil?
+
+        @params[:n_jobs] <= 0 ? Etc.nprocessors : @params[:n_jobs]
       end
     end
   end
@@ -17,9 +17,13 @@ module Rumale
       include Base::Regressor
 
       # Return the network.
-      # @return [Rumale::NeuralNetwork::Model::Sequential]
+      # @return [Rumale::NeuralNetwork::Model::FusedSequential]
       attr_reader :network
 
+      # Return the frozen inference-only network created by the compile method.
+      # @return [Rumale::NeuralNetwork::Model::CompiledNetwork]
+      attr_reader :compiled_network
+
       # Return the number of iterations run for optimization
       # @return [Integer]
       attr_reader :n_iter
@@ -40,14 +44,17 @@ module Rumale
       # @param batch_size [Intger] The size of the mini batches.
       # @param tol [Float] The tolerance of loss for terminating optimization.
       # @param verbose [Boolean] The flag indicating whether to output loss during iteration.
+      # @param n_jobs [Integer] The number of threads for matrix multiplication in the native extension.
+      #   If nil is given, the calculation runs on a single thread.
+      #   If zero or less is given, it becomes equal to the number of processors.
       # @param random_seed [Integer] The seed value using to initialize the random generator.
       def initialize(hidden_units: [128, 128], dropout_rate: 0.4, learning_rate: 0.001, decay1: 0.9, decay2: 0.999,
-                     max_iter: 200, batch_size: 50, tol: 1e-4, verbose: false, random_seed: nil)
+                     max_iter: 200, batch_size: 50, tol: 1e-4, verbose: false, n_jobs: nil, random_seed: nil)
         check_params_type(Array, hidden_units: hidden_units)
         check_params_numeric(dropout_rate: dropout_rate, learning_rate: learning_rate, decay1: decay1, decay2: decay2,
                              max_iter: max_iter, batch_size: batch_size, tol: tol)
         check_params_boolean(verbose: verbose)
-        check_params_numeric_or_nil(random_seed: random_seed)
+        check_params_numeric_or_nil(n_jobs: n_jobs, random_seed: random_seed)
         super
         @network = nil
       end
@@ -69,6 +76,7 @@ module Rumale
 
         loss = Loss::MeanSquaredError.new
         @network = buld_network(n_features, n_targets, sub_rng)
+        @compiled_network = nil
         @network = train(x, y, @network, loss, sub_rng)
         @network.delete_dropout
 
@@ -81,7 +89,7 @@ module Rumale
       # @return [Numo::DFloat] (shape: [n_samples, n_outputs]) Predicted values per sample.
       def predict(x)
         x = check_convert_sample_array(x)
-        out, = @network.forward(x)
+        out = predict_network(x)
         out = out[true, 0] if out.shape[1] == 1
         out
       end
@@ -2,6 +2,7 @@
 
 require 'rumale/validation'
 require 'rumale/base/base_estimator'
+require 'rumale/base/member_estimators'
 
 module Rumale
   module Pipeline
@@ -22,6 +23,7 @@ module Rumale
     #
     class FeatureUnion
       include Base::BaseEstimator
+      include Base::MemberEstimators
       include Validation
 
       # Return the transformers
@@ -31,9 +33,15 @@ module Rumale
       # Create a new feature union.
       #
       # @param transformers [Hash] List of transformers.  The order of transforms follows the insertion order of hash keys.
-      def initialize(transformers:)
+      # @param n_jobs [Integer] The number of jobs for running the fit and transform methods of transformers in parallel.
+      #   If nil is given, the methods do not execute in parallel.
+      #   If zero or less is given, it becomes equal to the number of processors.
+      #   This parameter is ignored if the Parallel gem is not loaded.
+      def initialize(transformers:, n_jobs: nil)
         check_params_type(Hash, transformers: transformers)
+        check_params_numeric_or_nil(n_jobs: n_jobs)
         @params = {}
+        @params[:n_jobs] = n_jobs
         @transformers = transformers
       end
 
@@ -43,7 +51,7 @@ module Rumale
       # @param y [Numo::NArray/Nil] (shape: [n_samples, n_outputs]) The target values or labels to be used for fitting the transformers.
       # @return [FeatureUnion] The learned feature union itself.
       def fit(x, y = nil)
-        @transformers.each { |_k, t| t.fit(x, y) }
+        fit_members(@transformers, x, y)
         self
       end
 
@@ -59,10 +67,44 @@ module Rumale
       # Transform the given data with the learned model.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The data to be transformed with the learned transformers.
-      # @return [Numo::DFloat] (shape: [n_samples, sum_n_components]) The transformed and concatenated data.
+      # @return [Numo::NArray] (shape: [n_samples, sum_n_components]) The transformed and concatenated data.
+      #   The data type is the upper type of the results of transformers.
       def transform(x)
-        z = @transformers.values.map { |t| t.transform(x) }
-        Numo::NArray.hstack(z)
+        # the outputs of parallel jobs are returned at once, and the empty data can not be used for detecting the output sizes.
+        return concatenate_outputs(x) if enable_parallel? || x.shape[0].zero?
+
+        output_types = detect_output_types(x)
+        z = output_types.values.map(&:first).reduce { |a, b| a.upcast(b) }.zeros(x.shape[0], output_types.values.sum(&:last))
+        # each result of transformers is written into its column block as soon as it is produced.
+        f_start = 0
+        each_member_output(@transformers, :transform, x) do |name, zt|
+          f_start = write_block(z, zt, f_start, output_types[name].last)
+        end
+        z
+      end
+
+      private
+
+      def concatenate_outputs(x)
+        outputs = []
+        each_member_output(@transformers, :transform, x) { |_name, zt| outputs.push(zt) }
+        widths = outputs.map { |zt| zt.ndim == 1 ? 1 : zt.shape[1] }
+        z = outputs.map(&:class).reduce { |a, b| a.upcast(b) }.zeros(outputs.first.shape[0], widths.sum)
+        outputs.zip(widths).inject(0) { |f_start, (zt, width)| write_block(z, zt, f_start, width) }
+        z
+      end
+
+      def detect_output_types(x)
+        x_head = x[0...1, true]
+        @transformers.each_with_object({}) do |(name, t), obj|
+          zt = t.transform(x_head)
+          obj[name] = [zt.class, zt.ndim == 1 ? 1 : zt.shape[1]]
+        end
+      end
+
+      def write_block(z, zt, f_start, width)
+        z[true, zt.ndim == 1 ? f_start : f_start...(f_start + width)] = zt
+        f_start + width
       end
     end
   end
@@ -1,5 +1,7 @@
 # frozen_string_literal: true
 
+require 'digest'
+require 'fileutils'
 require 'rumale/validation'
 require 'rumale/base/base_estimator'
 
@@ -15,6 +17,15 @@ module Rumale
     #   pipeline.fit(training_samples, traininig_labels)
     #   results = pipeline.predict(testing_samples)
     #
+    # @example
+    #   # The fitted PCA is reused for all the values of reg_param on each split of cross validation.
+    #   pca = Rumale::Decomposition::PCA.new(n_components: 16)
+    #   svc = Rumale::LinearModel::SVC.new(random_seed: 1)
+    #   pipeline = Rumale::Pipeline::Pipeline.new(steps: { pca: pca, svc: svc }, memory: '/tmp/rumale_cache')
+    #   kf = Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5)
+    #   gs = Rumale::ModelSelection::GridSearchCV.new(estimator: pipeline, param_grid: { svc__reg_param: [0.01, 0.1, 1.0] }, splitter: kf)
+    #   gs.fit(training_samples, traininig_labels)
+    #
     class Pipeline
       include Base::BaseEstimator
       include Validation
@@ -27,10 +38,19 @@ module Rumale
       #
       # @param steps [Hash] List of transformers and estimators. The order of transforms follows the insertion order of hash keys.
       #   The last entry is considered an estimator.
-      def initialize(steps:)
+      # @param memory [String] The path of directory to cache the fitted transformers and the transformed data.
+      #   The cache is keyed by the parameters of transformer and the fingerprint of input data, so the transformer
+      #   is not fitted again for the same data, such as when the pipelines that differ only in the last estimator are
+      #   fitted on each split of cross validation in grid search. The cache is shared by the worker processes.
+      #   The cache files are not removed automatically, so the directory grows with each new data and parameters.
+      #   Call the clear_cache method to remove them.
+      #   If nil is given, the transformers are not cached.
+      def initialize(steps:, memory: nil)
         check_params_type(Hash, steps: steps)
+        check_params_type_or_nil(String, memory: memory)
         validate_steps(steps)
         @params = {}
+        @params[:memory] = memory unless memory.nil?
         @steps = steps
       end
 
@@ -135,6 +155,16 @@ module Rumale
         last_estimator.score(trans_x, y)
       end
 
+      # Remove the cache files of fitted transformers and transformed data in the memory directory.
+      #
+      # @return [Pipeline] The pipeline itself.
+      def clear_cache
+        return self if @params[:memory].nil?
+
+        FileUtils.rm_f(Dir.glob(File.join(@params[:memory], '*.dat')))
+        self
+      end
+
       private
 
       def validate_steps(steps)
@@ -157,19 +187,67 @@ module Rumale
 
       def apply_transforms(x, y = nil, fit: false)
         trans_x = x
+        # the cache key of each transformer is chained from the fingerprint of input data through the preceding transformers.
+        cache_key = fit && !@params[:memory].nil? ? data_fingerprint(x, y) : nil
         @steps.keys[0...-1].each do |name|
           transformer = @steps[name]
           next if transformer.nil?
 
-          transformer.fit(trans_x, y) if fit
-          trans_x = transformer.transform(trans_x)
+          if cache_key.nil?
+            transformer.fit(trans_x, y) if fit
+            trans_x = transformer.transform(trans_x)
+          else
+            cache_key = Digest::SHA256.hexdigest(Marshal.dump([cache_key, transformer.class.name, transformer.params]))
+            trans_x = cached_fit_transform(cache_key, transformer, trans_x, y)
+          end
+        end
+        trans_x
+      end
+
+      def cached_fit_transform(cache_key, transformer, x, y)
+        path = File.join(@params[:memory], "#{cache_key}.dat")
+        if File.exist?(path)
+          # the state of cached transformer is copied into the given one, so that the objects in steps stay the same.
+          cached_transformer, trans_x = Marshal.load(File.binread(path))
+          cached_transformer.instance_variables.each do |var|
+            transformer.instance_variable_set(var, cached_transformer.instance_variable_get(var))
+          end
+          return trans_x
         end
+
+        transformer.fit(x, y)
+        trans_x = transformer.transform(x)
+        # the cache file is renamed after writing so that the other processes do not read the incomplete file.
+        FileUtils.mkdir_p(@params[:memory])
+        tmp_path = "#{path}.#{Process.pid}.tmp"
+        File.binwrite(tmp_path, Marshal.dump([transformer, trans_x]))
+        File.rename(tmp_path, path)
         trans_x
       end
 
+      def data_fingerprint(x, y)
+        digest = Digest::SHA256.new
+        [x, y].each do |arr|
+          next digest.update('nil') if arr.nil?
+
+          arr = Numo::NArray.asarray(arr)
+          digest.update(Marshal.dump([arr.class.name, arr.shape]))
+          # the rows are read in blocks, since the data may be the view that refers to the rows of the larger dataset.
+          n_rows = arr.shape[0]
+          (0...n_rows).step(FINGERPRINT_BLOCK_SIZE) do |head|
+            rows = head...[head + FINGERPRINT_BLOCK_SIZE, n_rows].min
+            digest.update(arr.ndim == 1 ? arr[rows].to_binary : arr[rows, true].to_binary)
+          end
+        end
+        digest.hexdigest
+      end
+
       def last_estimator
         @steps[@steps.keys.last]
       end
+
+      FINGERPRINT_BLOCK_SIZE = 4096
+      private_constant :FINGERPRINT_BLOCK_SIZE
     end
   end
 end
@@ -26,9 +26,21 @@ module Rumale
     #   #  [0, 1],
     #   #  [2, 3],
     #   #  [0, 0]]
+    #
+    #   # The indices of bins can be obtained as compact integer array.
+    #   discretizer = Rumale::Preprocessing::BinDiscretizer.new(n_bins: 4, dtype: Numo::UInt8)
+    #   transformed = discretizer.fit_transform(samples)
+    #   # > pp transformed
+    #   # Numo::UInt8#shape=[5,2]
+    #   # [[0, 1],
+    #   #  [3, 0],
+    #   #  [0, 1],
+    #   #  [2, 3],
+    #   #  [0, 0]]
     class BinDiscretizer
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtBinDiscretizer
 
       # Return the feature steps to be used discretizing.
       # @return [Array<Numo::DFloat>] (shape: [n_features, n_bins])
@@ -37,9 +49,21 @@ module Rumale
       # Create a new discretizer for features with given number of bins.
       #
       # @param n_bins [Integer] The number of bins to be used disretizing feature values.
-      def initialize(n_bins: 32)
+      # @param dtype [Class] The class of the discretized samples (Numo::DFloat, Numo::UInt8, Numo::UInt16 or Numo::Int32).
+      #   The integer types require that the indices of bins can be represented in them.
+      def initialize(n_bins: 32, dtype: Numo::DFloat)
+        check_params_numeric(n_bins: n_bins)
+        check_params_positive(n_bins: n_bins)
+        unless OUTPUT_MAX_BINS.key?(dtype)
+          raise ArgumentError, 'Expect dtype to be Numo::DFloat, Numo::UInt8, Numo::UInt16 or Numo::Int32.'
+        end
+        if n_bins > OUTPUT_MAX_BINS[dtype]
+          raise ArgumentError, "Expect the number of bins to be less than or equal to #{OUTPUT_MAX_BINS[dtype]}."
+        end
+
         @params = {}
         @params[:n_bins] = n_bins
+        @params[:dtype] = dtype
         @feature_steps = nil
       end
 
@@ -65,7 +89,7 @@ module Rumale
       # @overload fit_transform(x) -> Numo::DFloat
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be discretized.
-      # @return [Numo::DFloat] The discretized samples.
+      # @return [Numo::DFloat/Numo::UInt8/Numo::UInt16/Numo::Int32] The discretized samples.
       def fit_transform(x, _y = nil)
         x = check_convert_sample_array(x)
         fit(x).transform(x)
@@ -74,20 +98,22 @@ module Rumale
       # Peform discretizing the given samples.
       #
       # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be discretized.
-      # @return [Numo::DFloat] The discretized samples.
+      # @return [Numo::DFloat/Numo::UInt8/Numo::UInt16/Numo::Int32] The discretized samples.
       def transform(x)
         x = check_convert_sample_array(x)
-        n_samples, n_features = x.shape
-        transformed = Numo::DFloat.zeros(n_samples, n_features)
-        n_features.times do |n|
-          steps = @feature_steps[n]
-          @params[:n_bins].times do |bin|
-            mask = x[true, n].ge(steps[bin]).where
-            transformed[mask, n] = bin
-          end
-        end
+        # the native method reads the steps of each column of samples from the rows of stacked steps.
+        raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless x.shape[1] == @feature_steps.size
+
+        transformed = @params[:dtype].zeros(*x.shape)
+        discretize(x, Numo::DFloat.vstack(@feature_steps), transformed)
         transformed
       end
+
+      private
+
+      OUTPUT_MAX_BINS = { Numo::DFloat => Float::INFINITY, Numo::UInt8 => 256, Numo::UInt16 => 65_536, Numo::Int32 => 2**31 }.freeze
+
+      private_constant :OUTPUT_MAX_BINS
     end
   end
 end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/rumaleext'
 
 module Rumale
   module Preprocessing
@@ -14,15 +15,26 @@ module Rumale
     class MaxAbsScaler
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtScaler
 
       # Return the vector consists of the maximum absolute value for each feature.
       # @return [Numo::DFloat] (shape: [n_features])
       attr_reader :max_abs_vec
 
+      # Return the number of samples used to calculate the maximum absolute values.
+      # @return [Integer]
+      attr_reader :n_samples_seen
+
       # Creates a new normalizer for scaling each feature with its maximum absolute value.
-      def initialize
+      #
+      # @param copy [Boolean] The flag indicating whether to copy the given samples on transform.
+      #   If false, the transform method scales the given Numo::DFloat samples in place to reduce memory usage.
+      def initialize(copy: true)
+        check_params_boolean(copy: copy)
         @params = {}
+        @params[:copy] = copy
         @max_abs_vec = nil
+        @n_samples_seen = nil
       end
 
       # Calculate the minimum and maximum value of each feature for scaling.
@@ -33,10 +45,33 @@ module Rumale
       # @return [MaxAbsScaler]
       def fit(x, _y = nil)
         x = check_convert_sample_array(x)
+        @n_samples_seen, = x.shape
         @max_abs_vec = x.abs.max(0)
         self
       end
 
+      # Update the maximum absolute value of each feature with the given chunk of samples.
+      #
+      # @overload partial_fit(x) -> MaxAbsScaler
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to update maximum absolute value for each feature.
+      # @return [MaxAbsScaler]
+      def partial_fit(x, _y = nil)
+        x = check_convert_sample_array(x)
+        update_statistics(x.shape[0], x.abs.max(0))
+      end
+
+      # Merge the maximum absolute values of the other normalizer fitted on a different set of samples.
+      #
+      # @param other [MaxAbsScaler] The normalizer to be merged.
+      # @return [MaxAbsScaler]
+      def merge(other)
+        raise ArgumentError, 'Expect other to be MaxAbsScaler' unless other.is_a?(MaxAbsScaler)
+        return self if other.n_samples_seen.nil?
+
+        update_statistics(other.n_samples_seen, other.max_abs_vec)
+      end
+
       # Calculate the maximum absolute value for each feature, and then normalize samples.
       #
       # @overload fit_transform(x) -> Numo::DFloat
@@ -54,7 +89,33 @@ module Rumale
       # @return [Numo::DFloat] The scaled samples.
       def transform(x)
         x = check_convert_sample_array(x)
-        x / @max_abs_vec
+        x = x.dup if @params[:copy] || !x.contiguous?
+        transform!(x)
+      end
+
+      # Perform scaling the given samples with maximum absolute value for each feature in place.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the scaled values.
+      # @return [Numo::DFloat] The given samples after scaling.
+      def transform!(x)
+        check_inplace_sample_array(x, @max_abs_vec.size)
+        scale_features(x, Numo::DFloat.zeros(@max_abs_vec.size), @max_abs_vec, 1.0, 0.0)
+        x
+      end
+
+      private
+
+      def update_statistics(n_samples, max_abs_vec)
+        if @n_samples_seen.nil?
+          @n_samples_seen = n_samples
+          @max_abs_vec = max_abs_vec.dup
+        else
+          raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless max_abs_vec.size == @max_abs_vec.size
+
+          @n_samples_seen += n_samples
+          @max_abs_vec = Numo::DFloat.vstack([@max_abs_vec, max_abs_vec]).max(0)
+        end
+        self
       end
     end
   end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/rumaleext'
 
 module Rumale
   module Preprocessing
@@ -13,14 +14,20 @@ module Rumale
     class MaxNormalizer
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtNormalizer
 
       # Return the vector consists of the maximum norm for each sample.
       # @return [Numo::DFloat] (shape: [n_samples])
       attr_reader :norm_vec # :nodoc:
 
       # Create a new normalizer for normaliing to max-norm.
-      def initialize
+      #
+      # @param copy [Boolean] The flag indicating whether to copy the given samples on transform.
+      #   If false, the fit_transform and transform methods normalize the given Numo::DFloat samples in place to reduce memory usage.
+      def initialize(copy: true)
+        check_params_boolean(copy: copy)
         @params = {}
+        @params[:copy] = copy
         @norm_vec = nil
       end
 
@@ -45,8 +52,8 @@ module Rumale
       # @return [Numo::DFloat] The normalized samples.
       def fit_transform(x, _y = nil)
         x = check_convert_sample_array(x)
-        fit(x)
-        x / @norm_vec.expand_dims(1)
+        x = x.dup if @params[:copy] || !x.contiguous?
+        transform!(x)
       end
 
       # Calculate the maximum norms of each sample, and then normalize samples with the norms.
@@ -57,6 +64,17 @@ module Rumale
       def transform(x)
         fit_transform(x)
       end
+
+      # Calculate the maximum norms of each sample, and then normalize samples with the norms in place.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the normalized values.
+      # @return [Numo::DFloat] The given samples after normalization.
+      def transform!(x)
+        check_inplace_sample_array(x)
+        @norm_vec = Numo::DFloat.zeros(x.shape[0])
+        normalize_samples(x, @norm_vec, :max)
+        x
+      end
     end
   end
 end
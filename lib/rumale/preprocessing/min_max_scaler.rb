@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/rumaleext'
 
 module Rumale
   # This module consists of the classes that perform preprocessings.
@@ -15,6 +16,7 @@ module Rumale
     class MinMaxScaler
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtScaler
 
       # Return the vector consists of the minimum value for each feature.
       # @return [Numo::DFloat] (shape: [n_features])
@@ -24,15 +26,24 @@ module Rumale
       # @return [Numo::DFloat] (shape: [n_features])
       attr_reader :max_vec
 
+      # Return the number of samples used to calculate the minimum and maximum values.
+      # @return [Integer]
+      attr_reader :n_samples_seen
+
       # Creates a new normalizer for scaling each feature to a given range.
       #
       # @param feature_range [Array<Float>] The desired range of samples.
-      def initialize(feature_range: [0.0, 1.0])
+      # @param copy [Boolean] The flag indicating whether to copy the given samples on transform.
+      #   If false, the transform method scales the given Numo::DFloat samples in place to reduce memory usage.
+      def initialize(feature_range: [0.0, 1.0], copy: true)
         check_params_type(Array, feature_range: feature_range)
+        check_params_boolean(copy: copy)
         @params = {}
         @params[:feature_range] = feature_range
+        @params[:copy] = copy
         @min_vec = nil
         @max_vec = nil
+        @n_samples_seen = nil
       end
 
       # Calculate the minimum and maximum value of each feature for scaling.
@@ -43,11 +54,34 @@ module Rumale
       # @return [MinMaxScaler]
       def fit(x, _y = nil)
         x = check_convert_sample_array(x)
+        @n_samples_seen, = x.shape
         @min_vec = x.min(0)
         @max_vec = x.max(0)
         self
       end
 
+      # Update the minimum and maximum value of each feature with the given chunk of samples.
+      #
+      # @overload partial_fit(x) -> MinMaxScaler
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to update the minimum and maximum values.
+      # @return [MinMaxScaler]
+      def partial_fit(x, _y = nil)
+        x = check_convert_sample_array(x)
+        update_statistics(x.shape[0], x.min(0), x.max(0))
+      end
+
+      # Merge the minimum and maximum values of the other normalizer fitted on a different set of samples.
+      #
+      # @param other [MinMaxScaler] The normalizer to be merged.
+      # @return [MinMaxScaler]
+      def merge(other)
+        raise ArgumentError, 'Expect other to be MinMaxScaler' unless other.is_a?(MinMaxScaler)
+        return self if other.n_samples_seen.nil?
+
+        update_statistics(other.n_samples_seen, other.min_vec, other.max_vec)
+      end
+
       # Calculate the minimum and maximum values, and then normalize samples to feature_range.
       #
       # @overload fit_transform(x) -> Numo::DFloat
@@ -65,11 +99,38 @@ module Rumale
       # @return [Numo::DFloat] The scaled samples.
       def transform(x)
         x = check_convert_sample_array(x)
-        n_samples, = x.shape
+        x = x.dup if @params[:copy] || !x.contiguous?
+        transform!(x)
+      end
+
+      # Perform scaling the given samples according to feature_range in place.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the scaled values.
+      # @return [Numo::DFloat] The given samples after scaling.
+      def transform!(x)
+        check_inplace_sample_array(x, @min_vec.size)
         dif_vec = @max_vec - @min_vec
         dif_vec[dif_vec.eq(0)] = 1.0
-        nx = (x - @min_vec.tile(n_samples, 1)) / dif_vec.tile(n_samples, 1)
-        nx * (@params[:feature_range][1] - @params[:feature_range][0]) + @params[:feature_range][0]
+        range_min, range_max = @params[:feature_range].map(&:to_f)
+        scale_features(x, @min_vec, dif_vec, range_max - range_min, range_min)
+        x
+      end
+
+      private
+
+      def update_statistics(n_samples, min_vec, max_vec)
+        if @n_samples_seen.nil?
+          @n_samples_seen = n_samples
+          @min_vec = min_vec.dup
+          @max_vec = max_vec.dup
+        else
+          raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless min_vec.size == @min_vec.size
+
+          @n_samples_seen += n_samples
+          @min_vec = Numo::DFloat.vstack([@min_vec, min_vec]).min(0)
+          @max_vec = Numo::DFloat.vstack([@max_vec, max_vec]).max(0)
+        end
+        self
       end
     end
   end
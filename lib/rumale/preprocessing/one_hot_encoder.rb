@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/csr_matrix'
 
 module Rumale
   module Preprocessing
@@ -19,9 +20,17 @@ module Rumale
     #   #  [0, 0, 0, 1],
     #   #  [0, 0, 1, 0],
     #   #  [0, 1, 0, 0]]
+    #
+    #   # The one-hot-vectors can be obtained as sparse matrix in CSR format.
+    #   encoder = Rumale::Preprocessing::OneHotEncoder.new(sparse: true)
+    #   one_hot_vectors = encoder.fit_transform(labels)
+    #   # > pp one_hot_vectors.indices
+    #   # Numo::Int32#shape=[6]
+    #   # [0, 0, 2, 3, 2, 1]
     class OneHotEncoder
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtOneHotEncoder
 
       # Return the maximum values for each feature.
       # @return [Numo::Int32] (shape: [n_features])
@@ -36,8 +45,17 @@ module Rumale
       attr_reader :feature_indices
 
       # Create a new encoder for encoding categorical integer features to one-hot-vectors
-      def initialize
+      #
+      # @param sparse [Boolean] The flag indicating whether to return the one-hot-vectors as sparse matrix in CSR format.
+      # @param dtype [Class] The class of the dense one-hot-vectors (Numo::DFloat or Numo::Int32).
+      #   This parameter is ignored if sparse is true.
+      def initialize(sparse: false, dtype: Numo::DFloat)
+        check_params_boolean(sparse: sparse)
+        raise ArgumentError, 'Expect dtype to be Numo::DFloat or Numo::Int32.' unless [Numo::DFloat, Numo::Int32].include?(dtype)
+
         @params = {}
+        @params[:sparse] = sparse
+        @params[:dtype] = dtype
         @n_values = nil
         @active_features = nil
         @feature_indices = nil
@@ -54,7 +72,9 @@ module Rumale
 
         @n_values = x.max(0) + 1
         @feature_indices = Numo::Int32.hstack([[0], @n_values]).cumsum
-        @active_features = encode(x, @feature_indices).sum(0).ne(0).where
+        counts = Numo::Int32.zeros(@feature_indices[-1])
+        one_hot_count(x.ndim == 1 ? x.expand_dims(1) : x, @feature_indices, counts)
+        @active_features = counts.ne(0).where
         self
       end
 
@@ -63,7 +83,7 @@ module Rumale
       # @overload fit_transform(x) -> Numo::DFloat
       #
       # @param x [Numo::Int32] (shape: [n_samples, n_features]) The samples to encode into one-hot-vectors.
-      # @return [Numo::DFloat] The one-hot-vectors.
+      # @return [Numo::DFloat/Numo::Int32/Rumale::CSRMatrix] The one-hot-vectors.
       def fit_transform(x, _y = nil)
         x = Numo::Int32.cast(x) unless x.is_a?(Numo::Int32)
         raise ArgumentError, 'Expected the input samples only consists of non-negative integer values.' if x.lt(0).any?
@@ -73,26 +93,33 @@ module Rumale
       end
 
       # Encode samples into one-hot-vectors.
+      # The values that do not occur in the training set are ignored.
       #
       # @param x [Numo::Int32] (shape: [n_samples, n_features]) The samples to encode into one-hot-vectors.
-      # @return [Numo::DFloat] The one-hot-vectors.
+      # @return [Numo::DFloat/Numo::Int32/Rumale::CSRMatrix] The one-hot-vectors.
       def transform(x)
         x = Numo::Int32.cast(x) unless x.is_a?(Numo::Int32)
         raise ArgumentError, 'Expected the input samples only consists of non-negative integer values.' if x.lt(0).any?
 
-        codes = encode(x, @feature_indices)
-        codes[true, @active_features].dup
-      end
+        x = x.expand_dims(1) if x.ndim == 1
+        # the native methods look up the offsets of categories with the column index of samples.
+        raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless x.shape[1] == @feature_indices.size - 1
+
+        n_samples = x.shape[0]
+        n_codes = @active_features.size
+        active_map = Numo::Int32.new(@feature_indices[-1]).fill(-1)
+        active_map[@active_features] = Numo::Int32.new(n_codes).seq if n_codes.positive?
 
-      private
+        if @params[:sparse]
+          indices = Numo::Int32.zeros(x.size)
+          indptr = Numo::Int64.zeros(n_samples + 1)
+          one_hot_encode_csr(x, @feature_indices, active_map, indices, indptr)
+          nnz = indptr[-1]
+          return Rumale::CSRMatrix.new(Numo::DFloat.ones(nnz), indices[0...nnz].dup, indptr, [n_samples, n_codes])
+        end
 
-      def encode(x, indices)
-        n_samples, n_features = x.shape
-        n_features = 1 if n_features.nil?
-        col_indices = (x + indices[0...-1]).flatten.to_a
-        row_indices = Numo::Int32.new(n_samples).seq.repeat(n_features).to_a
-        codes = Numo::DFloat.zeros(n_samples, indices[-1])
-        row_indices.zip(col_indices).each { |r, c| codes[r, c] = 1.0 }
+        codes = @params[:dtype].zeros(n_samples, n_codes)
+        one_hot_encode_dense(x, @feature_indices, active_map, codes)
         codes
       end
     end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/csr_matrix'
 
 module Rumale
   module Preprocessing
@@ -20,6 +21,16 @@ module Rumale
     #   #  [1, 2, 3, 4, 6, 9],
     #   #  [1, 4, 5, 16, 20, 25]]
     #
+    #   # If only the products of distinct features are needed, set interaction_only to true.
+    #   transformer = Rumale::Preprocessing::PolynomialFeatures.new(degree: 2, interaction_only: true)
+    #   z = transformer.fit_transform(x)
+    #   p z
+    #
+    #   # Numo::DFloat#shape=[3,4]
+    #   # [[1, 0, 1, 0],
+    #   #  [1, 2, 3, 6],
+    #   #  [1, 4, 5, 20]]
+    #
     #   # If you want to perform polynomial regression, combine it with LinearRegression as follows:
     #   ply = Rumale::Preprocessing::PolynomialFeatures.new(degree: 2)
     #   reg = Rumale::LinearModel::LinearRegression.new(fit_bias: false, random_seed: 1)
@@ -30,6 +41,7 @@ module Rumale
     class PolynomialFeatures
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtPolynomialFeatures
 
       # Return the number of polynomial features.
       # @return [Integer]
@@ -38,26 +50,32 @@ module Rumale
       # Create a transformer for generating polynomial features.
       #
       # @param degree [Integer] The degree of polynomial features.
-      def initialize(degree: 2)
+      # @param interaction_only [Boolean] The flag indicating whether to generate only the products of distinct features.
+      def initialize(degree: 2, interaction_only: false)
         check_params_numeric(degree: degree)
+        check_params_boolean(interaction_only: interaction_only)
         raise ArgumentError, 'Expect the value of degree parameter greater than or eqaul to 1.' if degree < 1
 
         @params = {}
         @params[:degree] = degree
+        @params[:interaction_only] = interaction_only
         @n_output_features = nil
+        @n_features = nil
       end
 
       # Calculate the number of output polynomial fetures.
       #
       # @overload fit(x) -> PolynomialFeatures
-      #   @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to calculate the number of output polynomial fetures.
+      #   @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features])
+      #     The samples to calculate the number of output polynomial fetures.
       # @return [PolynomialFeatures]
       def fit(x, _y = nil)
-        x = check_convert_sample_array(x)
+        x = check_convert_sample_array(x) unless x.is_a?(Rumale::CSRMatrix)
         n_features = x.shape[1]
+        @n_features = n_features
         @n_output_features = 1
         @params[:degree].times do |t|
-          @n_output_features += Array.new(n_features) { |n| n }.repeated_combination(t + 1).size
+          @n_output_features += n_monomials(n_features, t + 1)
         end
         self
       end
@@ -65,45 +83,72 @@ module Rumale
       # Calculate the number of polynomial features, and then transform samples to polynomial features.
       #
       # @overload fit_transform(x) -> Numo::DFloat
-      #   @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to calculate the number of polynomial features
-      #     and be transformed.
-      # @return [Numo::DFloat] (shape: [n_samples, n_output_features]) The transformed samples.
+      #   @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features])
+      #     The samples to calculate the number of polynomial features and be transformed.
+      # @return [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_output_features]) The transformed samples.
       def fit_transform(x, _y = nil)
-        x = check_convert_sample_array(x)
+        x = check_convert_sample_array(x) unless x.is_a?(Rumale::CSRMatrix)
         fit(x).transform(x)
       end
 
       # Transform the given samples to polynomial features.
+      # The monomials of each degree are arranged in lexicographic order of the feature indices.
+      # If the sparse matrix in CSR format is given, only the monomials consisting of the stored elements are
+      # stored in the transformed matrix, and the column indices of the given matrix are assumed to be sorted in each row.
       #
-      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The samples to be transformed.
-      # @return [Numo::DFloat] (shape: [n_samples, n_output_features]) The transformed samples.
+      # @param x [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_features]) The samples to be transformed.
+      # @return [Numo::DFloat/Rumale::CSRMatrix] (shape: [n_samples, n_output_features]) The transformed samples.
       def transform(x)
+        return transform_sparse(x) if x.is_a?(Rumale::CSRMatrix)
+
         x = check_convert_sample_array(x)
-        # initialize transformed features
-        n_samples, n_features = x.shape
-        z = Numo::DFloat.zeros(n_samples, n_output_features)
-        # bias
-        z[true, 0] = 1
-        curr_col = 1
-        # itself
-        z[true, 1..n_features] = x
-        curr_col += n_features
-        # high degree features
-        curr_feat_ids = Array.new(n_features + 1) { |n| n + 1 }
-        (1...@params[:degree]).each do
-          next_feat_ids = []
-          n_features.times do |d|
-            f_range = curr_feat_ids[d]...curr_feat_ids.last
-            next_col = curr_col + f_range.size
-            z[true, curr_col...next_col] = z[true, f_range] * x[true, d..d]
-            next_feat_ids.push(curr_col)
-            curr_col = next_col
-          end
-          next_feat_ids.push(curr_col)
-          curr_feat_ids = next_feat_ids
-        end
+        check_n_features(x.shape[1])
+        z = Numo::DFloat.zeros(x.shape[0], n_output_features)
+        polynomial_expand(x, z, @params[:degree], @params[:interaction_only])
         z
       end
+
+      private
+
+      # The native methods write the monomials into the columns determined by the number of features at fitting,
+      # so the samples with a different number of features lead to out-of-bounds access.
+      def check_n_features(n_features)
+        raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless n_features == @n_features
+      end
+
+      # The native method ranks the monomials by the positions of stored elements in each row,
+      # so the column indices in each row must be sorted in ascending order without duplicates.
+      def check_sorted_indices(x)
+        return if x.nnz < 2
+
+        ascending = (x.indices[1..-1] - x.indices[0...-1]).gt(0)
+        row_heads = x.indptr[1...-1]
+        row_heads = row_heads[row_heads.gt(0) & row_heads.lt(x.nnz)]
+        ascending[row_heads - 1] = 1 unless row_heads.empty?
+        raise ArgumentError, 'Expect the column indices in each row to be sorted in ascending order without duplicates' unless ascending.all?
+      end
+
+      def transform_sparse(x)
+        check_n_features(x.shape[1])
+        check_sorted_indices(x)
+        if n_output_features > Numo::Int32::MAX
+          raise ArgumentError, 'Expect the number of output polynomial features to be representable in 32-bit integer.'
+        end
+
+        indptr = Numo::Int64.zeros(x.shape[0] + 1)
+        polynomial_csr_indptr(x.indptr, indptr, @params[:degree], @params[:interaction_only])
+        data = Numo::DFloat.zeros(indptr[-1])
+        indices = Numo::Int32.zeros(indptr[-1])
+        polynomial_csr_expand(x.data, x.indices, x.indptr, data, indices, x.shape[1], @params[:degree], @params[:interaction_only])
+        Rumale::CSRMatrix.new(data, indices, indptr, [x.shape[0], n_output_features])
+      end
+
+      def n_monomials(n_features, degree)
+        n = @params[:interaction_only] ? n_features : n_features + degree - 1
+        return 0 if n < degree
+
+        (1..degree).reduce(1) { |acc, i| acc * (n - degree + i) / i }
+      end
     end
   end
 end
@@ -2,6 +2,7 @@
 
 require 'rumale/base/base_estimator'
 require 'rumale/base/transformer'
+require 'rumale/rumaleext'
 
 module Rumale
   # This module consists of the classes that perform preprocessings.
@@ -12,9 +13,14 @@ module Rumale
     #   normalizer = Rumale::Preprocessing::StandardScaler.new
     #   new_training_samples = normalizer.fit_transform(training_samples)
     #   new_testing_samples = normalizer.transform(testing_samples)
+    #
+    #   # The statistics can also be accumulated from chunks of samples.
+    #   normalizer = Rumale::Preprocessing::StandardScaler.new
+    #   chunks.each { |chunk| normalizer.partial_fit(chunk) }
     class StandardScaler
       include Base::BaseEstimator
       include Base::Transformer
+      include ExtScaler
 
       # Return the vector consists of the mean value for each feature.
       # @return [Numo::DFloat] (shape: [n_features])
@@ -24,11 +30,21 @@ module Rumale
       # @return [Numo::DFloat] (shape: [n_features])
       attr_reader :std_vec
 
+      # Return the number of samples used to calculate the statistics.
+      # @return [Integer]
+      attr_reader :n_samples_seen
+
       # Create a new normalizer for centering and scaling to unit variance.
-      def initialize
+      #
+      # @param copy [Boolean] The flag indicating whether to copy the given samples on transform.
+      #   If false, the transform method scales the given Numo::DFloat samples in place to reduce memory usage.
+      def initialize(copy: true)
+        check_params_boolean(copy: copy)
         @params = {}
+        @params[:copy] = copy
         @mean_vec = nil
         @std_vec = nil
+        @n_samples_seen = nil
       end
 
       # Calculate the mean value and standard deviation of each feature for scaling.
@@ -40,11 +56,41 @@ module Rumale
       # @return [StandardScaler]
       def fit(x, _y = nil)
         x = check_convert_sample_array(x)
+        @n_samples_seen, = x.shape
         @mean_vec = x.mean(0)
+        @sq_dev_vec = nil
         @std_vec = x.stddev(0)
         self
       end
 
+      # Update the mean value and standard deviation of each feature with the given chunk of samples.
+      # The statistics are accumulated by the parallel variant of Welford's algorithm,
+      # so fitting the chunks one by one gives the same result as fitting all samples at once.
+      #
+      # @overload partial_fit(x) -> StandardScaler
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features])
+      #   The samples to update the mean values and standard deviations.
+      # @return [StandardScaler]
+      def partial_fit(x, _y = nil)
+        x = check_convert_sample_array(x)
+        n_samples, = x.shape
+        mean_vec = x.mean(0)
+        update_statistics(n_samples, mean_vec, ((x - mean_vec)**2).sum(0))
+      end
+
+      # Merge the statistics of the other normalizer fitted on a different set of samples.
+      # This is useful for combining the statistics of shards calculated in parallel.
+      #
+      # @param other [StandardScaler] The normalizer to be merged.
+      # @return [StandardScaler]
+      def merge(other)
+        raise ArgumentError, 'Expect other to be StandardScaler' unless other.is_a?(StandardScaler)
+        return self if other.n_samples_seen.nil?
+
+        update_statistics(other.n_samples_seen, other.mean_vec, other.sum_squared_deviations)
+      end
+
       # Calculate the mean values and standard deviations, and then normalize samples using them.
       #
       # @overload fit_transform(x) -> Numo::DFloat
@@ -63,8 +109,49 @@ module Rumale
       # @return [Numo::DFloat] The scaled samples.
       def transform(x)
         x = check_convert_sample_array(x)
-        n_samples, = x.shape
-        (x - @mean_vec.tile(n_samples, 1)) / @std_vec.tile(n_samples, 1)
+        x = x.dup if @params[:copy] || !x.contiguous?
+        transform!(x)
+      end
+
+      # Perform standardization the given samples in place.
+      #
+      # @param x [Numo::DFloat] (shape: [n_samples, n_features]) The contiguous samples to be overwritten with the scaled values.
+      # @return [Numo::DFloat] The given samples after scaling.
+      def transform!(x)
+        check_inplace_sample_array(x, @mean_vec.size)
+        scale_features(x, @mean_vec, @std_vec, 1.0, 0.0)
+        x
+      end
+
+      protected
+
+      def sum_squared_deviations
+        return @sq_dev_vec unless @sq_dev_vec.nil?
+
+        # the standard deviations of a single sample are not defined, but its squared deviations are zero.
+        return Numo::DFloat.zeros(@mean_vec.size) if @n_samples_seen == 1
+
+        @std_vec**2 * (@n_samples_seen - 1)
+      end
+
+      private
+
+      def update_statistics(n_samples, mean_vec, sq_dev_vec)
+        if @n_samples_seen.nil?
+          @n_samples_seen = n_samples
+          @mean_vec = mean_vec.dup
+          @sq_dev_vec = sq_dev_vec.dup
+        else
+          raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless mean_vec.size == @mean_vec.size
+
+          n_total = @n_samples_seen + n_samples
+          delta = mean_vec - @mean_vec
+          @sq_dev_vec = sum_squared_deviations + sq_dev_vec + delta**2 * (@n_samples_seen * n_samples.fdiv(n_total))
+          @mean_vec += delta * n_samples.fdiv(n_total)
+          @n_samples_seen = n_total
+        end
+        @std_vec = Numo::NMath.sqrt(@sq_dev_vec / (@n_samples_seen - 1))
+        self
       end
     end
   end
@@ -1,8 +1,14 @@
 # frozen_string_literal: true
 
+require 'etc'
+require 'rumale/rumaleext'
+require 'rumale/values'
+
 module Rumale
   # @!visibility private
   module Utils
+    extend ExtRandom
+
     module_function
 
     # @!visibility private
@@ -21,22 +27,54 @@ module Rumale
     end
 
     # @!visibility private
-    def rand_uniform(shape, rng = nil)
+    # The random numbers are generated by the native xoshiro256** generator seeded from the given random generator,
+    # so the result is determined by the state of the given random generator regardless of the number of threads.
+    # The buffer is filled with n_jobs threads, and all processors are used by default.
+    def rand_uniform(shape, rng = nil, n_jobs: -1)
       rng ||= Random.new
-      if shape.is_a?(Array)
-        rnd_vals = Array.new(shape.inject(:*)) { rng.rand }
-        Numo::DFloat.asarray(rnd_vals).reshape(shape[0], shape[1])
-      else
-        Numo::DFloat.asarray(Array.new(shape) { rng.rand })
-      end
+      rnd_vals = Numo::DFloat.new(*shape)
+      fill_uniform(rnd_vals, rand_seed(rng), n_threads(n_jobs))
+      rnd_vals
     end
 
     # @!visibility private
-    def rand_normal(shape, rng = nil, mu = 0.0, sigma = 1.0)
+    def rand_normal(shape, rng = nil, mu = 0.0, sigma = 1.0, n_jobs: -1)
       rng ||= Random.new
-      a = rand_uniform(shape, rng)
-      b = rand_uniform(shape, rng)
-      (Numo::NMath.sqrt(Numo::NMath.log(a) * -2.0) * Numo::NMath.sin(b * 2.0 * Math::PI)) * sigma + mu
+      rnd_vals = Numo::DFloat.new(*shape)
+      fill_normal(rnd_vals, rand_seed(rng), mu.to_f, sigma.to_f, n_threads(n_jobs))
+      rnd_vals
+    end
+
+    # @!visibility private
+    def rand_seed(rng)
+      Numo::UInt64.cast(Array.new(4) { rng.rand(1..Rumale::Values.int_max) })
+    end
+
+    # @!visibility private
+    # Check whether the processing with the given number of jobs can be executed in parallel with the Parallel gem.
+    def enable_parallel?(n_jobs)
+      return false if n_jobs.nil?
+
+      if defined?(Parallel).nil?
+        warn('If you want to use parallel option, you should install and load Parallel in advance.')
+        return false
+      end
+      true
+    end
+
+    # @!visibility private
+    # Return the number of native threads for the given number of jobs. Unlike n_processes, it does not need the Parallel gem.
+    def n_threads(n_jobs)
+      return 1 if n_jobs.nil?
+
+      n_jobs <= 0 ? Etc.nprocessors : n_jobs
+    end
+
+    # @!visibility private
+    def n_processes(n_jobs)
+      return 1 unless enable_parallel?(n_jobs)
+
+      n_jobs <= 0 ? Parallel.processor_count : n_jobs
     end
   end
 end
@@ -27,6 +27,16 @@ module Rumale
       y
     end
 
+    # @!visibility private
+    def check_inplace_sample_array(x, n_features = nil)
+      raise TypeError, 'Expect class of sample matrix to be Numo::DFloat' unless x.is_a?(Numo::DFloat)
+      raise ArgumentError, 'Expect sample matrix to be 2-D array' unless x.ndim == 2
+      raise ArgumentError, 'Expect sample matrix to be contiguous array' unless x.contiguous?
+      raise ArgumentError, 'Expect to have the same number of features as the fitted samples' unless n_features.nil? || x.shape[1] == n_features
+
+      nil
+    end
+
     # @deprecated Use check_convert_sample_array instead of this method.
     # @!visibility private
     def check_sample_array(x)
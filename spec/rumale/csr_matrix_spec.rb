@@ -0,0 +1,57 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::CSRMatrix do
+  let(:dense) { Numo::DFloat[[1, 0, 2, 0], [0, 0, 0, 0], [0, 3, 0, 4]] }
+  let(:matrix) { described_class.from_dense(dense) }
+  let(:copied) { Marshal.load(Marshal.dump(matrix)) }
+
+  it 'converts the dense matrix to the compressed sparse row format.', :aggregate_failures do
+    expect(matrix.shape).to eq([3, 4])
+    expect(matrix.nnz).to eq(4)
+    expect(matrix.data).to be_a(Numo::DFloat)
+    expect(matrix.data).to eq(Numo::DFloat[1, 2, 3, 4])
+    expect(matrix.indices).to be_a(Numo::Int32)
+    expect(matrix.indices).to eq(Numo::Int32[0, 2, 1, 3])
+    expect(matrix.indptr).to be_a(Numo::Int64)
+    expect(matrix.indptr).to eq(Numo::Int64[0, 2, 2, 4])
+  end
+
+  it 'restores the dense matrix.' do
+    expect(matrix.to_dense).to eq(dense)
+  end
+
+  it 'compares with other sparse matrix.', :aggregate_failures do
+    expect(matrix).to eq(described_class.new([1, 2, 3, 4], [0, 2, 1, 3], [0, 2, 2, 4], [3, 4]))
+    expect(matrix).not_to eq(described_class.new([1, 2, 3, 5], [0, 2, 1, 3], [0, 2, 2, 4], [3, 4]))
+  end
+
+  it 'dumps and restores itself using Marshal module.' do
+    expect(copied).to eq(matrix)
+  end
+
+  context 'when the matrix has no non-zero elements' do
+    let(:dense) { Numo::DFloat.zeros(2, 3) }
+
+    it 'converts the dense matrix to the compressed sparse row format.', :aggregate_failures do
+      expect(matrix.nnz).to eq(0)
+      expect(matrix.indptr).to eq(Numo::Int64[0, 0, 0])
+      expect(matrix.to_dense).to eq(dense)
+    end
+  end
+
+  it 'raises ArgumentError when given the arrays with inconsistent sizes.', :aggregate_failures do
+    expect { described_class.new([1, 2], [0], [0, 2], [1, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([1, 2], [0, 1], [0, 2], [2, 3]) }.to raise_error(ArgumentError)
+  end
+
+  it 'raises ArgumentError when given the arrays that point outside of the matrix.', :aggregate_failures do
+    expect { described_class.new([1, 2], [0, 3], [0, 2], [1, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([1, 2], [-1, 1], [0, 2], [1, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([1, 2], [0, 1], [1, 2], [1, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([1, 2], [0, 1], [0, 1], [1, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([1, 2], [0, 1], [0, 2, 1, 2], [3, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.new([], [], [0], [-1, 3]) }.to raise_error(ArgumentError)
+  end
+end
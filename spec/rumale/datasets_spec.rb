@@ -72,6 +72,38 @@ RSpec.describe Rumale::Dataset do
       m, = described_class.load_libsvm_file(__dir__ + '/../test_zb.t', zero_based: true, n_features: 2)
       expect(m.shape[1]).to eq(matrix_dbl.shape[1])
     end
+
+    it 'loads libsvm .t file as a sparse matrix', :aggregate_failures do
+      m, t = described_class.load_libsvm_file(__dir__ + '/../test_dbl.t', sparse: true)
+      expect(m).to be_a(Rumale::CSRMatrix)
+      expect(m.shape).to eq(matrix_dbl.shape)
+      expect(m.nnz).to eq(11)
+      expect(m.to_dense).to eq(matrix_dbl)
+      expect(t).to eq(target_variables)
+    end
+
+    it 'loads libsvm .t file in parallel', :aggregate_failures do
+      m, l = described_class.load_libsvm_file(__dir__ + '/../test_int.t', dtype: Numo::Int32, n_jobs: 4)
+      expect(m).to eq(matrix_int)
+      expect(l).to eq(labels)
+      m, t = described_class.load_libsvm_file(__dir__ + '/../test_dbl.t', n_jobs: -1)
+      expect(m).to eq(matrix_dbl)
+      expect(t).to eq(target_variables)
+    end
+
+    it 'skips blank lines and comments', :aggregate_failures do
+      File.write(__dir__ + '/../dump_comment.t', "# header\n1,2 1:0.5 3:2\r\n\n-1,0.5 2:1 # comment\n")
+      m, t = described_class.load_libsvm_file(__dir__ + '/../dump_comment.t', n_jobs: 2)
+      expect(m).to eq(Numo::DFloat[[0.5, 0, 2], [0, 1, 0]])
+      expect(t).to eq(Numo::DFloat[[1, 2], [-1, 0.5]])
+    end
+
+    it 'raises ArgumentError when given a malformed file', :aggregate_failures do
+      File.write(__dir__ + '/../dump_invalid.t', "1 1:0.5\n2 1:foo\n")
+      expect { described_class.load_libsvm_file(__dir__ + '/../dump_invalid.t') }.to raise_error(ArgumentError, /line 2/)
+      File.write(__dir__ + '/../dump_invalid.t', "1 1:0.5\n2 0:1\n")
+      expect { described_class.load_libsvm_file(__dir__ + '/../dump_invalid.t') }.to raise_error(ArgumentError, /index/)
+    end
   end
 
   describe '#dump_libsvm_file' do
@@ -95,6 +127,109 @@ RSpec.describe Rumale::Dataset do
       expect(m).to eq(matrix_dbl)
       expect(l).to eq(labels)
     end
+
+    it 'dumps sparse features in CSR format', :aggregate_failures do
+      described_class.dump_libsvm_file(Rumale::CSRMatrix.from_dense(matrix_dbl), labels, __dir__ + '/../dump_csr.t')
+      expect(File.read(__dir__ + '/../dump_csr.t').lines.first).to eq("1 1:5 2:3.1 4:8.4\n")
+      m, l = described_class.load_libsvm_file(__dir__ + '/../dump_csr.t')
+      expect(m).to eq(matrix_dbl)
+      expect(l).to eq(labels)
+    end
+
+    it 'dumps floating point values that are read back to the same values', :aggregate_failures do
+      x = Numo::DFloat.new(5, 3).rand - 0.5
+      y = Numo::DFloat.new(5).rand
+      described_class.dump_libsvm_file(x, y, __dir__ + '/../dump_prec.t')
+      m, t = described_class.load_libsvm_file(__dir__ + '/../dump_prec.t')
+      expect(m).to eq(x)
+      expect(t).to eq(y)
+    end
+  end
+
+  describe '#save_binary' do
+    it 'saves and loads the dense matrix and labels', :aggregate_failures do
+      described_class.save_binary(__dir__ + '/../dump_dense.rbd', matrix_dbl, labels)
+      m, l = described_class.load_binary(__dir__ + '/../dump_dense.rbd')
+      expect(m.class).to eq(Numo::DFloat)
+      expect(m).to eq(matrix_dbl)
+      expect(l.class).to eq(Numo::Int32)
+      expect(l).to eq(labels)
+    end
+
+    it 'saves and loads the sparse matrix', :aggregate_failures do
+      x = Rumale::CSRMatrix.from_dense(matrix_dbl)
+      described_class.save_binary(__dir__ + '/../dump_sparse.rbd', x, target_variables)
+      m, t = described_class.load_binary(__dir__ + '/../dump_sparse.rbd')
+      expect(m.class).to eq(Rumale::CSRMatrix)
+      expect(m).to eq(x)
+      expect(t).to eq(target_variables)
+    end
+
+    it 'keeps the type of matrix and allows missing labels', :aggregate_failures do
+      described_class.save_binary(__dir__ + '/../dump_nolabel.rbd', matrix_int)
+      m, l = described_class.load_binary(__dir__ + '/../dump_nolabel.rbd')
+      expect(m.class).to eq(Numo::Int32)
+      expect(m).to eq(matrix_int)
+      expect(l).to be_nil
+    end
+
+    it 'raises ArgumentError when loading the file in a different format' do
+      expect { described_class.load_binary(__dir__ + '/../test_dbl.t') }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe '#each_batch' do
+    it 'reads the libsvm file in batches', :aggregate_failures do
+      batches = described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 4, n_features: 4).to_a
+      expect(batches.size).to eq(2)
+      expect(batches.map { |x, _| x.shape[0] }).to eq([4, 2])
+      expect(Numo::NArray.vstack(batches.map(&:first))).to eq(matrix_dbl)
+      expect(Numo::NArray.hstack(batches.map(&:last))).to eq(target_variables)
+    end
+
+    it 'reads the libsvm file as sparse matrices', :aggregate_failures do
+      xs = []
+      described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 5, n_features: 4, sparse: true, n_jobs: 2) { |x, _y| xs << x }
+      expect(xs.map(&:class).uniq).to eq([Rumale::CSRMatrix])
+      expect(Numo::NArray.vstack(xs.map(&:to_dense))).to eq(matrix_dbl)
+    end
+
+    it 'reads the csv file in batches', :aggregate_failures do
+      lines = matrix_dbl.to_a.zip(labels.to_a).map { |x, y| ([y] + x).join(',') }
+      File.write(__dir__ + '/../dump_batch.csv', lines.join("\n") + "\n")
+      batches = described_class.each_batch(__dir__ + '/../dump_batch.csv', batch_size: 3, format: :csv).to_a
+      expect(batches.size).to eq(2)
+      expect(Numo::NArray.vstack(batches.map(&:first))).to eq(matrix_dbl)
+      expect(batches.map(&:last).map(&:class).uniq).to eq([Numo::Int32])
+      expect(Numo::NArray.hstack(batches.map(&:last))).to eq(labels)
+    end
+
+    it 'reads the binary file in batches', :aggregate_failures do
+      described_class.save_binary(__dir__ + '/../dump_batch.rbd', matrix_dbl, labels)
+      batches = described_class.each_batch(__dir__ + '/../dump_batch.rbd', batch_size: 4, format: :binary).to_a
+      expect(Numo::NArray.vstack(batches.map(&:first))).to eq(matrix_dbl)
+      expect(Numo::NArray.hstack(batches.map(&:last))).to eq(labels)
+      described_class.save_binary(__dir__ + '/../dump_batch_csr.rbd', Rumale::CSRMatrix.from_dense(matrix_dbl), labels)
+      batches = described_class.each_batch(__dir__ + '/../dump_batch_csr.rbd', batch_size: 4, format: :binary).to_a
+      expect(batches.map { |x, _| x.shape }).to eq([[4, 4], [2, 4]])
+      expect(Numo::NArray.vstack(batches.map { |x, _| x.to_dense })).to eq(matrix_dbl)
+      expect(Numo::NArray.hstack(batches.map(&:last))).to eq(labels)
+    end
+
+    it 'feeds the batches to partial_fit method' do
+      scaler = Rumale::Preprocessing::StandardScaler.new
+      described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 2, n_features: 4) { |x, _y| scaler.partial_fit(x) }
+      expect((scaler.mean_vec - matrix_dbl.mean(0)).abs.max).to be < 1e-8
+    end
+
+    it 'raises ArgumentError on invalid arguments or contents', :aggregate_failures do
+      expect { described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 2) { nil } }.to raise_error(ArgumentError)
+      expect { described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 2, n_features: 2) { nil } }.to raise_error(ArgumentError)
+      expect { described_class.each_batch(__dir__ + '/../test_dbl.t', batch_size: 0, n_features: 4) { nil } }.to raise_error(ArgumentError)
+      File.write(__dir__ + '/../dump_invalid_batch.t', "1 1:2\n1 1:3\n1 a:3\n")
+      expect { described_class.each_batch(__dir__ + '/../dump_invalid_batch.t', batch_size: 2, n_features: 4) { nil } }
+        .to raise_error(ArgumentError, /line 3/)
+    end
   end
 
   describe '#make_circles' do
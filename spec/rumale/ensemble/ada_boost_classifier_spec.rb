@@ -77,6 +77,18 @@ RSpec.describe Rumale::Ensemble::AdaBoostClassifier do
       expect(predicted_by_probs).to eq(y)
     end
 
+    it 'predicts at each stage in the same way as the classifier learned with that number of estimators.', :aggregate_failures do
+      staged_probs = estimator.staged_predict_proba(x).to_a
+      staged_labels = estimator.staged_predict(x).to_a
+      n_stages = [3, estimator.estimators.size].min
+      partial = described_class.new(n_estimators: n_stages, max_features: 1, random_seed: 1).fit(x, y)
+      expect(staged_labels.size).to eq(estimator.estimators.size)
+      expect(staged_labels.last).to eq(predicted)
+      expect(estimator.staged_decision_function(x).to_a[n_stages - 1]).to eq(partial.decision_function(x))
+      expect(staged_probs[n_stages - 1]).to eq(partial.predict_proba(x))
+      expect(staged_labels[n_stages - 1]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.estimators.size).to eq(copied.estimators.size)
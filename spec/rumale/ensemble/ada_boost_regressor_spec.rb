@@ -32,6 +32,15 @@ RSpec.describe Rumale::Ensemble::AdaBoostRegressor do
       expect(score).to be_within(0.01).of(1.0)
     end
 
+    it 'predicts at each stage in the same way as the regressor learned with that number of estimators.', :aggregate_failures do
+      staged_predicted = estimator.staged_predict(x).to_a
+      n_stages = [3, estimator.estimators.size].min
+      partial = described_class.new(n_estimators: n_stages, criterion: 'mae', max_features: 2, random_seed: 9).fit(x, y)
+      expect(staged_predicted.size).to eq(estimator.estimators.size)
+      expect(staged_predicted.last).to eq(predicted)
+      expect(staged_predicted[n_stages - 1]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.estimators.size).to eq(copied.estimators.size)
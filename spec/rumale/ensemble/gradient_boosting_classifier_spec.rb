@@ -79,6 +79,19 @@ RSpec.describe Rumale::Ensemble::GradientBoostingClassifier do
       expect(predicted_by_probs).to eq(y)
     end
 
+    it 'predicts at each stage in the same way as the classifier learned with that number of estimators.', :aggregate_failures do
+      staged_scores = estimator.staged_decision_function(x).to_a
+      staged_probs = estimator.staged_predict_proba(x).to_a
+      staged_labels = estimator.staged_predict(x).to_a
+      partial = described_class.new(n_estimators: 4, learning_rate: 0.9, max_features: 1, random_seed: 1).fit(x, y)
+      expect(staged_scores.size).to eq(n_estimators)
+      expect(staged_scores.last).to eq(estimator.decision_function(x))
+      expect(staged_labels.last).to eq(estimator.predict(x))
+      expect(staged_scores[3]).to eq(partial.decision_function(x))
+      expect(staged_probs[3]).to eq(partial.predict_proba(x))
+      expect(staged_labels[3]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggeregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.params).to match(copied.params)
@@ -43,6 +43,14 @@ RSpec.describe Rumale::Ensemble::GradientBoostingRegressor do
       expect(leaf_ids[true, 0]).to eq(estimator.estimators[0].apply(x))
     end
 
+    it 'predicts at each stage in the same way as the regressor learned with that number of estimators.', :aggregate_failures do
+      staged_predicted = estimator.staged_predict(x).to_a
+      partial = described_class.new(n_estimators: 4, learning_rate: 0.9, reg_lambda: 0.001, max_features: 1, random_seed: 9).fit(x, y)
+      expect(staged_predicted.size).to eq(n_estimators)
+      expect(staged_predicted.last).to eq(predicted)
+      expect(staged_predicted[3]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.params).to match(copied.params)
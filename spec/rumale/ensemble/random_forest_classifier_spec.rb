@@ -36,6 +36,26 @@ RSpec.describe Rumale::Ensemble::RandomForestClassifier do
       expect(estimator.feature_importances.shape[0]).to eq(n_features)
       expect(score).to eq(1.0)
     end
+
+    it 'learns the model with the subset of samples given by the indices.', :aggregate_failures do
+      ids = Array(0...n_samples).select(&:even?)
+      subset_estimator = described_class.new(n_estimators: n_estimators, max_depth: 2, max_features: 2, random_seed: 1)
+      subset_estimator.fit(x[ids, true], y[ids])
+      indexed_estimator = described_class.new(n_estimators: n_estimators, max_depth: 2, max_features: 2, random_seed: 1)
+      indexed_estimator.fit(x, y, sample_indices: ids)
+      expect(indexed_estimator.classes).to eq(subset_estimator.classes)
+      expect(indexed_estimator.apply(x)).to eq(subset_estimator.apply(x))
+      expect(indexed_estimator.predict_proba(x)).to eq(subset_estimator.predict_proba(x))
+    end
+
+    it 'raises ArgumentError when given invalid sample indices.', :aggregate_failures do
+      estimator = described_class.new(n_estimators: n_estimators, random_seed: 1)
+      expect(estimator.supports_sample_indices?).to be_truthy
+      expect { estimator.fit(x, y, sample_indices: [-1, 0]) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: [0, n_samples]) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: []) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: [0.5]) }.to raise_error(ArgumentError)
+    end
   end
 
   context 'when multiclass classification problem' do
@@ -78,6 +98,24 @@ RSpec.describe Rumale::Ensemble::RandomForestClassifier do
       expect(index_mat[true, 0]).to eq(estimator.estimators[0].apply(x))
     end
 
+    it 'predicts the label with the most votes of trees and breaks ties by the smallest label.', :aggregate_failures do
+      tree_labels = Numo::Int32[*estimator.estimators.map { |tree| tree.predict(x).to_a }].transpose
+      majority = Numo::Int32[*tree_labels.to_a.map { |labels| classes.max_by { |c| [labels.count(c), -c] } }]
+      expect(estimator.predict(x)).to be_a(Numo::Int32)
+      expect(estimator.predict(x)).to be_contiguous
+      expect(estimator.predict(x)).to eq(majority)
+    end
+
+    it 'predicts at each stage in the same way as the classifier learned with that number of estimators.', :aggregate_failures do
+      staged_probs = estimator.staged_predict_proba(x).to_a
+      staged_labels = estimator.staged_predict(x).to_a
+      partial = described_class.new(n_estimators: 3, max_depth: 2, max_features: 2, random_seed: 1).fit(x, y)
+      expect(staged_labels.size).to eq(n_estimators)
+      expect(staged_labels.last).to eq(estimator.predict(x))
+      expect(staged_probs[2]).to eq(partial.predict_proba(x))
+      expect(staged_labels[2]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.params).to match(copied.params)
@@ -46,6 +46,14 @@ RSpec.describe Rumale::Ensemble::RandomForestRegressor do
       expect(index_mat[true, 0]).to eq(estimator.estimators[0].apply(x))
     end
 
+    it 'predicts at each stage in the same way as the regressor learned with that number of estimators.', :aggregate_failures do
+      staged_predicted = estimator.staged_predict(x).to_a
+      partial = described_class.new(n_estimators: 4, criterion: 'mae', max_features: 2, random_seed: 9).fit(x, y)
+      expect(staged_predicted.size).to eq(n_estimators)
+      expect(staged_predicted.last).to eq(predicted)
+      expect(staged_predicted[3]).to eq(partial.predict(x))
+    end
+
     it 'dumps and restores itself using Marshal module.', :aggregate_failures do
       expect(estimator.class).to eq(copied.class)
       expect(estimator.params).to match(copied.params)
@@ -54,6 +62,22 @@ RSpec.describe Rumale::Ensemble::RandomForestRegressor do
       expect(estimator.rng).to eq(copied.rng)
       expect(score).to eq(copied.score(x, y))
     end
+
+    it 'learns the model with the subset of samples given by the indices.' do
+      ids = Array(0...n_samples).select(&:even?)
+      subset_estimator = described_class.new(n_estimators: n_estimators, criterion: 'mae', max_features: 2, random_seed: 9)
+      indexed_estimator = described_class.new(n_estimators: n_estimators, criterion: 'mae', max_features: 2, random_seed: 9)
+      expect(indexed_estimator.fit(x, y, sample_indices: ids).predict(x)).to eq(subset_estimator.fit(x[ids, true], y[ids]).predict(x))
+    end
+
+    it 'raises ArgumentError when given invalid sample indices.', :aggregate_failures do
+      estimator = described_class.new(n_estimators: n_estimators, random_seed: 1)
+      expect(estimator.supports_sample_indices?).to be_truthy
+      expect { estimator.fit(x, y, sample_indices: [-1, 0]) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: [0, n_samples]) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: []) }.to raise_error(ArgumentError)
+      expect { estimator.fit(x, y, sample_indices: [0.5]) }.to raise_error(ArgumentError)
+    end
   end
 
   context 'when multi-target problem' do
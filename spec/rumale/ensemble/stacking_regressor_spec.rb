@@ -76,6 +76,40 @@ RSpec.describe Rumale::Ensemble::StackingRegressor do
         expect(meta_features.shape[1]).to eq(n_components)
       end
 
+      it 'extracts the same meta features in parallel as sequential execution.' do
+        par_estimator = described_class.new(estimators: Marshal.load(Marshal.dump(estimators)), meta_estimator: meta_estimator,
+                                            n_jobs: -1, random_seed: 1)
+        expect(par_estimator.fit_transform(x, y)).to eq(meta_features)
+      end
+
+      it 'fits the estimators on each fold from the unfitted state in parallel and sequential execution.', :aggregate_failures do
+        stub_const('StackingFitCounter', Class.new do
+          def fit(_x, _y)
+            @n_fits = @n_fits.to_i + 1
+            self
+          end
+
+          def predict(x)
+            Numo::DFloat.new(x.shape[0]).fill(@n_fits)
+          end
+        end)
+        stub_const('StackingMetaRecorder', Class.new(Rumale::LinearModel::Ridge) do
+          attr_reader :meta_x
+
+          def fit(x, y)
+            @meta_x = x.dup
+            super
+          end
+        end)
+        meta_xs = [nil, -1].map do |n_jobs|
+          stacking = described_class.new(estimators: { cnt: StackingFitCounter.new }, meta_estimator: StackingMetaRecorder.new,
+                                         n_jobs: n_jobs, random_seed: 1)
+          stacking.fit(x, y).meta_estimator.meta_x
+        end
+        expect(meta_xs[0]).to eq(Numo::DFloat.ones(n_samples, 1))
+        expect(meta_xs[1]).to eq(meta_xs[0])
+      end
+
       context 'when concatenating original features' do
         let(:passthrough) { true }
 
@@ -57,6 +57,13 @@ RSpec.describe Rumale::Ensemble::VotingClassifier do
       expect(copied.classes).to eq(estimator.classes)
       expect(copied.score(x, y)).to eq(score)
     end
+
+    it 'predicts the same results in parallel as sequential execution.', :aggregate_failures do
+      par_estimator = described_class.new(estimators: Marshal.load(Marshal.dump(estimators)), n_jobs: -1).fit(x, y)
+      expect(par_estimator.decision_function(x)).to eq(func_vals)
+      expect(par_estimator.predict_proba(x)).to eq(probs)
+      expect(par_estimator.predict(x)).to eq(predicted)
+    end
   end
 
   context 'when multiclass classification problem' do
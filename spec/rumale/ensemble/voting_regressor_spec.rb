@@ -49,5 +49,10 @@ RSpec.describe Rumale::Ensemble::VotingRegressor do
       expect(copied.estimators.keys).to eq(estimator.estimators.keys)
       expect(copied.score(x, y)).to eq(score)
     end
+
+    it 'predicts the same values in parallel as sequential execution.' do
+      par_estimator = described_class.new(estimators: Marshal.load(Marshal.dump(estimators)), weights: weights, n_jobs: -1).fit(x, y)
+      expect(par_estimator.predict(x)).to eq(predicted)
+    end
   end
 end
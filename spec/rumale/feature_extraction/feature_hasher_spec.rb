@@ -36,6 +36,47 @@ RSpec.describe Rumale::FeatureExtraction::FeatureHasher do
     end
   end
 
+  context 'when the samples consisting of various feature names and values' do
+    let(:n_features) { 2**20 }
+    let(:x) do
+      [
+        { 'dog' => 1, :cat => 2.5, 42 => 3, :'東京' => 'ラーメン' },
+        { dog: 'shiba', run: -5, 'elephant' => 0 },
+        {}
+      ]
+    end
+    let(:expected) do
+      z = Numo::DFloat.zeros(x.size, n_features)
+      x.each_with_index do |f, i|
+        f.each do |k, v|
+          k = "#{k}=#{v}" if v.is_a?(String)
+          val = v.is_a?(String) ? 1 : v
+          next if val.zero?
+
+          h = Mmh3.hash32(k.to_s)
+          z[i, h.abs % n_features] = h >= 0 ? val : -val
+        end
+      end
+      z
+    end
+
+    it 'encodes in the same way as signed 32-bit Murmurhash3 in mmh3 gem' do
+      expect(z).to eq(expected)
+    end
+
+    context 'when sparse output is enabled' do
+      let(:encoder) { described_class.new(n_features: n_features, sparse: true) }
+
+      it 'encodes to sparse matrix in CSR format', :aggregate_failures do
+        expect(z).to be_a(Rumale::CSRMatrix)
+        expect(z.shape).to eq([3, n_features])
+        expect(z.nnz).to eq(6)
+        expect(z.indptr).to eq(Numo::Int64[0, 4, 6, 6])
+        expect(z.to_dense).to eq(expected)
+      end
+    end
+  end
+
   context 'when Mmh3 is not loaded' do
     let(:x) do
       [
@@ -51,8 +92,8 @@ RSpec.describe Rumale::FeatureExtraction::FeatureHasher do
 
     after { Mmh3 = @backup }
 
-    it 'raises Runtime error' do
-      expect { encoder.fit_transform(x) }.to raise_error(RuntimeError)
+    it 'encodes to sample array with the native hash function' do
+      expect(z).to eq(Numo::DFloat[[0, 0, -4, -1, 0, 0, 0, 0, 0, 2], [0, 0, 0, -2, -5, 0, 0, 0, 0, 0]])
     end
   end
 end
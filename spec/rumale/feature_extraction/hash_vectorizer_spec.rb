@@ -59,4 +59,29 @@ RSpec.describe Rumale::FeatureExtraction::HashVectorizer do
       expect(copied.vocabulary).to eq(encoder.vocabulary)
     end
   end
+
+  context 'when sparse output is enabled' do
+    let(:encoder) { described_class.new(sparse: true) }
+    let(:x) do
+      [
+        { city: 'Dubai',  temperature: 33 },
+        { city: 'London', temperature: 0 },
+        { city: 'San Francisco', temperature: 18 }
+      ]
+    end
+
+    it 'encodes to sparse matrix in CSR format', :aggregate_failures do
+      expect(z).to be_a(Rumale::CSRMatrix)
+      expect(z.shape).to eq([3, 4])
+      expect(z.indices).to eq(Numo::Int32[0, 3, 1, 2, 3])
+      expect(z.indptr).to eq(Numo::Int64[0, 2, 3, 5])
+      expect(z.to_dense).to eq(Numo::DFloat[[1, 0, 0, 33], [0, 1, 0, 0], [0, 0, 1, 18]])
+    end
+
+    it 'decodes sparse matrix to the array of feature-value hash' do
+      expect(encoder.inverse_transform(z)).to eq(
+        [{ city: 'Dubai', temperature: 33 }, { city: 'London' }, { city: 'San Francisco', temperature: 18 }]
+      )
+    end
+  end
 end
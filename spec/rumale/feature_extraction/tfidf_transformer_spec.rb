@@ -82,6 +82,35 @@ RSpec.describe Rumale::FeatureExtraction::TfidfTransformer do
     end
   end
 
+  context 'when given sparse matrix in CSR format' do
+    let(:x) { Numo::DFloat[[2, 0, 1], [0, 1, 3], [4, 0, 0], [0, 0, 0]] }
+    let(:x_sparse) { Rumale::CSRMatrix.from_dense(x) }
+    let(:z_sparse) { transformer.fit_transform(x_sparse) }
+
+    [%w[l2 true false true], %w[l1 false true false], %w[none true true true]].each do |nrm, idf, smooth, sublinear|
+      context "with norm: #{nrm}, use_idf: #{idf}, smooth_idf: #{smooth}, sublinear_tf: #{sublinear}" do
+        let(:norm) { nrm }
+        let(:use_idf) { idf == 'true' }
+        let(:smooth_idf) { smooth == 'true' }
+        let(:sublinear_tf) { sublinear == 'true' }
+
+        it 'returns the same tf-idf representation in CSR format as dense one', :aggregate_failures do
+          expect(z_sparse).to be_a(Rumale::CSRMatrix)
+          expect(z_sparse.indices).to eq(x_sparse.indices)
+          expect(z_sparse.indptr).to eq(x_sparse.indptr)
+          expect((z_sparse.to_dense - z).abs.max).to be < 1e-8
+          expect(x_sparse.data).to eq(Numo::DFloat[2, 1, 1, 3, 4])
+        end
+      end
+    end
+
+    it 'raises errors when given the samples with a different number of features or before fitting.', :aggregate_failures do
+      wide_x = Rumale::CSRMatrix.from_dense(Numo::DFloat[[0, 0, 0, 5]])
+      expect { transformer.fit(x_sparse).transform(wide_x) }.to raise_error(ArgumentError)
+      expect { described_class.new.transform(x_sparse) }.to raise_error(RuntimeError)
+    end
+  end
+
   it 'dumps and restores itself using Marshal module.', :aggregate_failures do
     transformer.fit(x)
     copied = Marshal.load(Marshal.dump(transformer))
@@ -103,4 +103,68 @@ RSpec.describe Rumale::ModelSelection::CrossValidation do
       expect(ovr_linear_svc_cv.send(:kernel_machine?)).to be_falsey
     end
   end
+
+  it 'evaluates the splits in parallel with the same results as sequential evaluation.', :aggregate_failures do
+    report = described_class.new(estimator: linear_svc, splitter: skfold, return_train_score: true).perform(samples, labels)
+    cv = described_class.new(estimator: linear_svc, splitter: skfold, return_train_score: true, n_jobs: -1)
+    par_report = cv.perform(samples, labels)
+    expect(cv.n_jobs).to eq(-1)
+    expect(par_report[:test_score]).to eq(report[:test_score])
+    expect(par_report[:train_score]).to eq(report[:train_score])
+    expect(par_report[:fit_time].size).to eq(n_splits)
+  end
+
+  it 'reports the calculation times and the resource usage of each split.', :aggregate_failures do
+    report = described_class.new(estimator: linear_svc, splitter: kfold, measure_memory: true).perform(samples, labels)
+    expect(report[:fit_time].size).to eq(n_splits)
+    expect(report[:fit_time]).to all(be_a(Float))
+    expect(report[:fit_time]).to all(be > 0)
+    expect(report[:score_time].size).to eq(n_splits)
+    expect(report[:score_time]).to all(be > 0)
+    expect(report[:allocated_objects].size).to eq(n_splits)
+    expect(report[:allocated_objects]).to all(be_positive)
+    expect(report[:peak_rss_delta].size).to eq(n_splits)
+    expect(report[:peak_rss_delta]).to all(be >= 0) if File.writable?('/proc/self/clear_refs')
+  end
+
+  it 'does not measure the peak resident set size unless the measure_memory is true.' do
+    report = described_class.new(estimator: linear_svc, splitter: kfold).perform(samples, labels)
+    expect(report[:peak_rss_delta]).to eq(Array.new(n_splits))
+  end
+
+  it 'reports the increase of peak resident set size of each split not only the first one.' do
+    skip 'The peak resident set size cannot be reset on this platform.' unless File.writable?('/proc/self/clear_refs')
+
+    # the estimator keeps the buffer allocated in each fitting, so that the memory is not reused in the later splits.
+    estimator = Class.new(Rumale::NaiveBayes::GaussianNB) do
+      def fit(x, y)
+        (@buffers ||= []).push(Numo::DFloat.new(4_000_000).fill(1.0))
+        super
+      end
+    end.new
+    report = described_class.new(estimator: estimator, splitter: kfold, measure_memory: true).perform(samples, labels)
+    expect(report[:peak_rss_delta][1..-1]).to all(be >= 16 * 1024 * 1024)
+  end
+
+  it 'fits the estimator accepting the sample indices on the whole dataset.', :aggregate_failures do
+    forest = Rumale::Ensemble::RandomForestClassifier.new(n_estimators: 5, max_depth: 3, random_seed: 1)
+    report = described_class.new(estimator: forest, splitter: skfold, return_train_score: true).perform(samples, labels)
+    expected = skfold.split(samples, labels).map do |train_ids, test_ids|
+      estimator = Marshal.load(Marshal.dump(forest)).fit(samples[train_ids, true], labels[train_ids])
+      estimator.score(samples[test_ids, true], labels[test_ids])
+    end
+    expect(report[:test_score]).to eq(expected)
+    expect(report[:train_score].size).to eq(n_splits)
+  end
+
+  it 'fits the estimator not accepting the sample indices on the subset of samples.', :aggregate_failures do
+    forest = Rumale::Ensemble::ExtraTreesClassifier.new(n_estimators: 5, max_depth: 3, random_seed: 1)
+    report = described_class.new(estimator: forest, splitter: skfold).perform(samples, labels)
+    expected = skfold.split(samples, labels).map do |train_ids, test_ids|
+      estimator = Marshal.load(Marshal.dump(forest)).fit(samples[train_ids, true], labels[train_ids])
+      estimator.score(samples[test_ids, true], labels[test_ids])
+    end
+    expect(forest.supports_sample_indices?).to be_falsey
+    expect(report[:test_score]).to eq(expected)
+  end
 end
@@ -65,6 +65,11 @@ RSpec.describe Rumale::ModelSelection::GridSearchCV do
     expect(gs.cv_results[:mean_fit_time].size).to eq(8)
     expect(gs.cv_results[:std_fit_time]).to be_a(Array)
     expect(gs.cv_results[:std_fit_time].size).to eq(8)
+    expect(gs.cv_results[:mean_score_time].size).to eq(8)
+    expect(gs.cv_results[:std_score_time].size).to eq(8)
+    expect(gs.cv_results[:max_peak_rss_delta].size).to eq(8)
+    expect(gs.cv_results[:mean_allocated_objects].size).to eq(8)
+    expect(gs.cv_results[:mean_fit_time]).to all(be > 0)
     expect(gs.best_params).to be_a(Hash)
     expect(gs.best_params[:rbf__gamma]).to eq(1.0)
     expect(gs.best_params[:rbf__n_components]).to eq(128)
@@ -95,6 +100,34 @@ RSpec.describe Rumale::ModelSelection::GridSearchCV do
     end
   end
 
+  it 'searches the best parameter in parallel with the same results as sequential search.', :aggregate_failures do
+    param_grid = { n_estimators: [2, 5], max_features: [1, 2] }
+    gs = described_class.new(estimator: rfr, param_grid: param_grid, splitter: kfold, evaluator: mae, greater_is_better: false)
+    gs.fit(x_reg, y_reg)
+    par_gs = described_class.new(estimator: rfr, param_grid: param_grid, splitter: kfold, evaluator: mae, greater_is_better: false,
+                                 n_jobs: -1)
+    par_gs.fit(x_reg, y_reg)
+    expect(par_gs.params[:n_jobs]).to eq(-1)
+    expect(par_gs.cv_results[:params]).to eq(gs.cv_results[:params])
+    expect(par_gs.cv_results[:mean_test_score]).to eq(gs.cv_results[:mean_test_score])
+    expect(par_gs.cv_results[:mean_train_score]).to eq(gs.cv_results[:mean_train_score])
+    expect(par_gs.best_params).to eq(gs.best_params)
+  end
+
+  it 'evaluates the numbers of estimators with the staged predictions of the largest ensemble.', :aggregate_failures do
+    gbc = Rumale::Ensemble::GradientBoostingClassifier.new(learning_rate: 0.5, random_seed: 1)
+    param_grid = { n_estimators: [2, 8, 4], max_depth: [1, 2] }
+    gs = described_class.new(estimator: gbc, param_grid: param_grid, splitter: skfold).fit(x, y)
+    expected = gs.cv_results[:params].map do |prms|
+      estimator = Rumale::Ensemble::GradientBoostingClassifier.new(learning_rate: 0.5, random_seed: 1, **prms)
+      cv = Rumale::ModelSelection::CrossValidation.new(estimator: estimator, splitter: skfold)
+      Numo::DFloat[*cv.perform(x, y)[:test_score]].mean
+    end
+    expect(gs.cv_results[:params].size).to eq(6)
+    expect(gs.cv_results[:mean_test_score]).to eq(expected)
+    expect(gs.best_estimator.params[:n_estimators]).to eq(gs.best_params[:n_estimators])
+  end
+
   it 'raises TypeError given a invalid param grid.' do
     expect { described_class.new(estimator: svc, param_grid: nil, splitter: skfold) }.to raise_error(TypeError)
     expect { described_class.new(estimator: svc, param_grid: [0], splitter: skfold) }.to raise_error(TypeError)
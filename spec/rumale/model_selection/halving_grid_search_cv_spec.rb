@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::ModelSelection::HalvingGridSearchCV do
+  let(:three_clusters) { three_clusters_dataset }
+  let(:x) { three_clusters[0] }
+  let(:y) { three_clusters[1] }
+  let(:x_reg) { two_clusters_dataset[0] }
+  let(:y_reg) { x_reg[true, 0] + x_reg[true, 1]**2 }
+  let(:kfold) { Rumale::ModelSelection::KFold.new(n_splits: 3, shuffle: true, random_seed: 1) }
+  let(:skfold) { Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5, shuffle: true, random_seed: 1) }
+  let(:svc) { Rumale::LinearModel::SVC.new(random_seed: 1) }
+  let(:rfr) { Rumale::Ensemble::RandomForestRegressor.new(random_seed: 1) }
+
+  it 'searches the best parameter by increasing the number of samples.', :aggregate_failures do
+    param_grid = { reg_param: [1e-4, 1e-3, 1e-2, 1e-1, 1, 1e1, 1e2, 1e3, 1e4] }
+    hs = described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, random_seed: 1)
+    hs.fit(x, y)
+    expect(hs.n_iterations).to eq(3)
+    expect(hs.n_candidates).to eq([9, 3, 1])
+    expect(hs.n_resources).to eq([33, 99, 297])
+    expect(hs.cv_results[:params].size).to eq(13)
+    expect(hs.cv_results[:iter]).to eq([0] * 9 + [1] * 3 + [2])
+    expect(hs.cv_results[:n_resources]).to eq([33] * 9 + [99] * 3 + [297])
+    expect(hs.best_index).to eq(12)
+    expect(hs.best_params).to eq(hs.cv_results[:params].last)
+    expect(param_grid[:reg_param]).to include(hs.best_params[:reg_param])
+    expect(hs.best_estimator.params[:reg_param]).to eq(hs.best_params[:reg_param])
+    expect(hs.score(x, y)).to be > 0.9
+  end
+
+  it 'searches the best parameter by increasing the value of parameter.', :aggregate_failures do
+    param_grid = { max_features: [1, 2], max_depth: [2, 4, nil] }
+    hs = described_class.new(estimator: rfr, param_grid: param_grid, splitter: kfold, resource: :n_estimators,
+                             min_resources: 1, max_resources: 9, n_jobs: -1)
+    hs.fit(x_reg, y_reg)
+    expect(hs.n_candidates).to eq([6, 2])
+    expect(hs.n_resources).to eq([1, 3])
+    expect(hs.cv_results[:params].first(6).map { |prms| prms[:n_estimators] }.uniq).to eq([1])
+    expect(hs.best_params[:n_estimators]).to eq(3)
+    expect(hs.best_estimator.params[:n_estimators]).to eq(3)
+    expect(hs.best_score).to eq(hs.cv_results[:mean_test_score].last(2).max)
+  end
+
+  it 'raises ArgumentError given invalid resource, factor, or amounts of resource.', :aggregate_failures do
+    param_grid = { reg_param: [0.1, 1.0] }
+    expect { described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, factor: 1) }.to raise_error(ArgumentError)
+    expect { described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, min_resources: 0) }.to raise_error(ArgumentError)
+    expect { described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, max_resources: 0) }.to raise_error(ArgumentError)
+    expect { described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, min_resources: -1) }.to raise_error(ArgumentError)
+    hs = described_class.new(estimator: svc, param_grid: param_grid, splitter: skfold, resource: :n_trees)
+    expect { hs.fit(x, y) }.to raise_error(ArgumentError)
+  end
+end
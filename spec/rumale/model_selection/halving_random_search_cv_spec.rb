@@ -0,0 +1,43 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::ModelSelection::HalvingRandomSearchCV do
+  let(:three_clusters) { three_clusters_dataset }
+  let(:x) { three_clusters[0] }
+  let(:y) { three_clusters[1] }
+  let(:skfold) { Rumale::ModelSelection::StratifiedKFold.new(n_splits: 5, shuffle: true, random_seed: 1) }
+  let(:svc) { Rumale::LinearModel::SVC.new(random_seed: 1) }
+  let(:param_distributions) { { reg_param: 1e-4..1e2, fit_bias: [true, false] } }
+
+  it 'searches the best parameter among the parameter sets drawn randomly.', :aggregate_failures do
+    hs = described_class.new(estimator: svc, param_distributions: param_distributions, splitter: skfold, random_seed: 1)
+    hs.fit(x, y)
+    expect(hs.n_candidates).to eq([9, 3, 1])
+    expect(hs.n_resources).to eq([30, 90, 270])
+    expect(hs.cv_results[:params].size).to eq(13)
+    expect(hs.cv_results[:params].map { |prms| prms[:reg_param] }).to all(be_between(1e-4, 1e2))
+    expect(hs.cv_results[:params].map { |prms| prms[:fit_bias] }).to all(be(true).or(be(false)))
+    expect(hs.best_params).to eq(hs.cv_results[:params].last)
+    expect(hs.score(x, y)).to be > 0.9
+  end
+
+  it 'draws the same parameter sets with the same random seed.' do
+    hs1 = described_class.new(estimator: svc, param_distributions: param_distributions, n_candidates: 4, splitter: skfold,
+                              random_seed: 1)
+    hs2 = described_class.new(estimator: svc, param_distributions: param_distributions, n_candidates: 4, splitter: skfold,
+                              random_seed: 1)
+    expect(hs1.fit(x, y).cv_results[:params]).to eq(hs2.fit(x, y).cv_results[:params])
+  end
+
+  it 'raises TypeError given invalid param distributions.', :aggregate_failures do
+    expect { described_class.new(estimator: svc, param_distributions: [param_distributions], splitter: skfold) }.to raise_error(TypeError)
+    expect { described_class.new(estimator: svc, param_distributions: { reg_param: 0.1 }, splitter: skfold) }.to raise_error(TypeError)
+  end
+
+  it 'raises ArgumentError given no amount of resource.', :aggregate_failures do
+    prms = { estimator: svc, param_distributions: param_distributions, splitter: skfold }
+    expect { described_class.new(**prms, min_resources: 0) }.to raise_error(ArgumentError)
+    expect { described_class.new(**prms, max_resources: 0) }.to raise_error(ArgumentError)
+  end
+end
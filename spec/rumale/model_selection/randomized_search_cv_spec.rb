@@ -0,0 +1,61 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::ModelSelection::RandomizedSearchCV do
+  let(:three_clusters) { three_clusters_dataset }
+  let(:x) { three_clusters[0] }
+  let(:y) { three_clusters[1] }
+  let(:skfold) { Rumale::ModelSelection::StratifiedKFold.new(n_splits: 3, shuffle: true, random_seed: 1) }
+  let(:svc) { Rumale::LinearModel::SVC.new(random_seed: 1) }
+  let(:param_distributions) do
+    { reg_param: ->(rng) { 10**rng.rand(-4.0..2.0) }, bias_scale: 0.5..2.0, fit_bias: [true, false] }
+  end
+
+  it 'searches the best parameter among the parameter sets drawn randomly.', :aggregate_failures do
+    rs = described_class.new(estimator: svc, param_distributions: param_distributions, n_iter: 6, splitter: skfold, random_seed: 1)
+    rs.fit(x, y)
+    expect(rs.cv_results[:params].size).to eq(6)
+    expect(rs.cv_results[:mean_test_score].size).to eq(6)
+    expect(rs.cv_results[:params].map { |prms| prms[:reg_param] }).to all(be_between(1e-4, 1e2))
+    expect(rs.cv_results[:params].map { |prms| prms[:bias_scale] }).to all(be_between(0.5, 2.0))
+    expect(rs.cv_results[:params].map { |prms| prms[:fit_bias] }).to all(be(true).or(be(false)))
+    expect(rs.best_score).to eq(rs.cv_results[:mean_test_score].max)
+    expect(rs.best_params).to eq(rs.cv_results[:params][rs.best_index])
+    expect(rs.best_estimator.params[:reg_param]).to eq(rs.best_params[:reg_param])
+    expect(rs.score(x, y)).to be > 0.9
+  end
+
+  it 'draws the same parameter sets with the same random seed in sequential and parallel search.', :aggregate_failures do
+    rs = described_class.new(estimator: svc, param_distributions: param_distributions, n_iter: 4, splitter: skfold, random_seed: 2)
+    par_rs = described_class.new(estimator: svc, param_distributions: param_distributions, n_iter: 4, splitter: skfold,
+                                 n_jobs: -1, random_seed: 2)
+    rs.fit(x, y)
+    par_rs.fit(x, y)
+    expect(par_rs.cv_results[:params]).to eq(rs.cv_results[:params])
+    expect(par_rs.cv_results[:mean_test_score]).to eq(rs.cv_results[:mean_test_score])
+  end
+
+  it 'dumps and restores itself using Marshal module with the distribution given as Proc.', :aggregate_failures do
+    rs = described_class.new(estimator: svc, param_distributions: param_distributions, n_iter: 3, splitter: skfold, random_seed: 1)
+    rs.fit(x, y)
+    copied = Marshal.load(Marshal.dump(rs))
+    expect(copied.cv_results).to eq(rs.cv_results)
+    expect(copied.best_params).to eq(rs.best_params)
+    expect(copied.score(x, y)).to eq(rs.score(x, y))
+    expect(copied.params[:param_distributions][:reg_param]).to match_array(rs.cv_results[:params].map { |prms| prms[:reg_param] }.uniq)
+    expect(copied.params[:param_distributions][:bias_scale]).to eq(0.5..2.0)
+    expect(rs.params[:param_distributions][:reg_param]).to be_a(Proc)
+  end
+
+  it 'stops evaluating the parameter sets when the budget of time is exhausted.' do
+    rs = described_class.new(estimator: svc, param_distributions: param_distributions, n_iter: 20, splitter: skfold,
+                             max_time: 0, random_seed: 1)
+    rs.fit(x, y)
+    expect(rs.cv_results[:params].size).to eq(1)
+  end
+
+  it 'raises TypeError given invalid param distributions.' do
+    expect { described_class.new(estimator: svc, param_distributions: { reg_param: 0.1 }, splitter: skfold) }.to raise_error(TypeError)
+  end
+end
@@ -0,0 +1,82 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::NeuralNetwork::Layer::FusedAffine do
+  let(:rng) { Random.new(1) }
+  let(:x) { Numo::DFloat[[1, 2], [3, 4], [5, 6]] }
+  let(:z) { Numo::DFloat[[1, 2, 3, 4], [5, 6, 7, 8], [9, 8, 7, 6]] }
+  let(:n_inputs) { x.shape[1] }
+  let(:n_outputs) { z.shape[1] }
+  let(:relu) { false }
+  let(:dropout_rate) { 0.0 }
+  let(:adam) { Rumale::NeuralNetwork::Optimizer::Adam.new }
+  let(:affine) do
+    described_class.new(n_inputs: n_inputs, n_outputs: n_outputs, relu: relu, dropout_rate: dropout_rate,
+                        optimizer: adam, rng: rng.dup)
+  end
+  let(:rand_mat) { 0.01 * Rumale::Utils.rand_normal([n_inputs, n_outputs], rng.dup) }
+
+  context 'when not applying activation function' do
+    it 'performs linear transform and its backward pass', :aggregate_failures do
+      out = affine.forward(x)
+      expect(out.class).to eq(Numo::DFloat)
+      expect(out.shape).to eq(z.shape)
+      expect((out - x.dot(rand_mat)).abs.max).to be < 1e-12
+      expect(affine.predict(x)).to eq(out)
+      dout = affine.backward(z.dup, true)
+      expect(dout.class).to eq(Numo::DFloat)
+      expect(dout.shape).to eq(x.shape)
+      expect((dout - z.dot(rand_mat.transpose)).abs.max).to be < 1e-12
+      expect(affine.weight).not_to eq(rand_mat)
+      expect(affine.backward(z.dup, false)).to be_nil
+    end
+  end
+
+  context 'when applying rectified linear function' do
+    let(:relu) { true }
+    let(:x) { Numo::DFloat[[1, -2], [-3, 4], [5, -6]] }
+
+    it 'performs linear transform followed by rectified linear function', :aggregate_failures do
+      linear = x.dot(rand_mat)
+      out = affine.forward(x)
+      expect((out - linear * linear.gt(0)).abs.max).to be < 1e-12
+      dout = affine.backward(z.dup, true)
+      expect((dout - (z * linear.gt(0)).dot(rand_mat.transpose)).abs.max).to be < 1e-12
+    end
+  end
+
+  context 'when performing dropout' do
+    let(:dropout_rate) { 0.6 }
+    let(:x) { Numo::DFloat.ones(10, 1) }
+    let(:z) { Numo::DFloat.ones(10, 10) }
+
+    it 'drops units only in training', :aggregate_failures do
+      expect(affine.forward(x).eq(0).count).to be_within(15).of(60)
+      expect(affine.predict(x).eq(0).count).to eq(0)
+      affine.delete_dropout
+      expect(affine.forward(x).eq(0).count).to eq(0)
+    end
+  end
+
+  it 'raises ArgumentError when the number of input columns differs from the number of inputs.', :aggregate_failures do
+    wide_x = Numo::DFloat.ones(3, n_inputs + 1)
+    expect { affine.forward(wide_x) }.to raise_error(ArgumentError)
+    expect { affine.predict(wide_x) }.to raise_error(ArgumentError)
+  end
+
+  it 'raises ArgumentError when the gradient of output values has a different shape from the output.', :aggregate_failures do
+    affine.forward(x)
+    expect { affine.backward(Numo::DFloat.ones(x.shape[0], n_outputs + 1), true) }.to raise_error(ArgumentError)
+    expect { affine.backward(Numo::DFloat.ones(x.shape[0], n_outputs - 1), false) }.to raise_error(ArgumentError)
+  end
+
+  it 'dumps and restores itself using Marshal module.', :aggregate_failures do
+    affine.forward(x)
+    affine.backward(z.dup, true)
+    copied = Marshal.load(Marshal.dump(affine.release_buffers))
+    expect(copied.weight).to eq(affine.weight)
+    expect(copied.bias).to eq(affine.bias)
+    expect(copied.predict(x)).to eq(affine.predict(x))
+  end
+end
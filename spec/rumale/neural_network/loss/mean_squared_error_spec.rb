@@ -12,4 +12,10 @@ RSpec.describe Rumale::NeuralNetwork::Loss::MeanSquaredError do
     expect(loss).to eq(5)
     expect(dout).to eq(Numo::DFloat[-1.5, -0.5, 0.5, 1.5])
   end
+
+  it 'calculates mean squared error and writes its gradient into the buffer', :aggregate_failures do
+    buf = Numo::DFloat.zeros(4, 1)
+    expect(described_class.new.fused_call(y.expand_dims(1), t.expand_dims(1), buf)).to eq(5)
+    expect(buf.flatten).to eq(Numo::DFloat[-1.5, -0.5, 0.5, 1.5])
+  end
 end
@@ -16,4 +16,10 @@ RSpec.describe Rumale::NeuralNetwork::Loss::SoftmaxCrossEntropy do
     expect(loss).to eq(-(t * Numo::NMath.log(z + 1e-8)).sum.fdiv(2))
     expect(dout).to eq((z - t) / 2)
   end
+
+  it 'calculates softmax cross entropy and writes its gradient into the buffer', :aggregate_failures do
+    buf = Numo::DFloat.zeros(2, 2)
+    expect(described_class.new.fused_call(y, t, buf)).to be_within(1e-12).of(loss)
+    expect((buf - dout).abs.max).to be < 1e-12
+  end
 end
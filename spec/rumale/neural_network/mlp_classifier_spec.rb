@@ -8,7 +8,8 @@ RSpec.describe Rumale::NeuralNetwork::MLPClassifier do
   let(:classes) { y.to_a.uniq.sort }
   let(:n_samples) { x.shape[0] }
   let(:n_classes) { classes.size }
-  let(:estimator) { described_class.new(hidden_units: [32, 16], max_iter: 100, verbose: false, random_seed: 1).fit(x, y) }
+  let(:n_jobs) { nil }
+  let(:estimator) { described_class.new(hidden_units: [32, 16], max_iter: 100, verbose: false, n_jobs: n_jobs, random_seed: 1).fit(x, y) }
   let(:predicted) { estimator.predict(x) }
   let(:probs) { estimator.predict_proba(x) }
   let(:score) { estimator.score(x, y) }
@@ -56,5 +57,30 @@ RSpec.describe Rumale::NeuralNetwork::MLPClassifier do
 
     it_behaves_like 'classification'
     it_behaves_like 'dump and load model'
+
+    context 'when running on multiple threads' do
+      let(:n_jobs) { -1 }
+
+      it_behaves_like 'classification'
+    end
+
+    context 'when compiling the learned network' do
+      let(:estimator) { described_class.new(hidden_units: [32, 16], max_iter: 100, verbose: false, random_seed: 1).fit(x, y).compile }
+      let(:compiled) { estimator.compiled_network }
+      let(:outputs) { estimator.network.predict(x) }
+
+      it_behaves_like 'classification'
+      it_behaves_like 'dump and load model'
+
+      it 'predicts with the frozen network having single-precision weights.', :aggregate_failures do
+        expect(compiled).to be_frozen
+        expect(compiled.weights).to be_a(Numo::SFloat)
+        expect(compiled.biases).to be_a(Numo::SFloat)
+        expect(compiled.layer_sizes.to_a).to eq([x.shape[1], 32, 16, n_classes])
+        expect((compiled.predict(x) - outputs).abs.max).to be < 1e-4
+        expect(compiled.predict(x[0, true]).shape).to eq([n_classes])
+        expect((compiled.predict(x[0, true]) - outputs[0, true]).abs.max).to be < 1e-4
+      end
+    end
   end
 end
@@ -9,7 +9,8 @@ RSpec.describe Rumale::NeuralNetwork::MLPRegressor do
   let(:n_samples) { x.shape[0] }
   let(:n_features) { x.shape[1] }
   let(:n_outputs) { y.shape[1] }
-  let(:estimator) { described_class.new(hidden_units: [128, 128], max_iter: 100, verbose: false, random_seed: 1).fit(x, y) }
+  let(:n_jobs) { nil }
+  let(:estimator) { described_class.new(hidden_units: [128, 128], max_iter: 100, verbose: false, n_jobs: n_jobs, random_seed: 1).fit(x, y) }
   let(:predicted) { estimator.predict(x) }
   let(:score) { estimator.score(x, y) }
   let(:copied) { Marshal.load(Marshal.dump(estimator)) }
@@ -44,5 +45,41 @@ RSpec.describe Rumale::NeuralNetwork::MLPRegressor do
 
     it_behaves_like 'regression'
     it_behaves_like 'dump and load model'
+
+    context 'when running on multiple threads' do
+      let(:n_jobs) { -1 }
+
+      it_behaves_like 'regression'
+    end
+
+    context 'when compiling the learned network' do
+      let(:estimator) { described_class.new(hidden_units: [128, 128], max_iter: 100, verbose: false, random_seed: 1).fit(x, y).compile }
+      let(:compiled) { estimator.compiled_network }
+
+      it_behaves_like 'regression'
+      it_behaves_like 'dump and load model'
+
+      it 'predicts with the frozen network having single-precision weights.', :aggregate_failures do
+        expect(compiled).to be_frozen
+        expect(compiled.weights).to be_a(Numo::SFloat)
+        expect((compiled.predict(x) - estimator.network.predict(x)).abs.max).to be < 1e-3
+        expect(compiled.predict(x[0, true]).shape).to eq([n_outputs])
+      end
+
+      it 'raises ArgumentError when the number of features differs from that of the network.' do
+        expect { compiled.predict(x[true, 1..-1]) }.to raise_error(ArgumentError)
+      end
+    end
+  end
+
+  it 'raises ArgumentError when gathering the rows out of range.', :aggregate_failures do
+    mlp = described_class.new
+    buf = Numo::DFloat.zeros(2, n_features)
+    mlp.send(:gather_rows, x, Numo::Int32[n_samples - 1, 0], 0, buf)
+    expect(buf).to eq(x[[n_samples - 1, 0], true])
+    expect { mlp.send(:gather_rows, x, Numo::Int32[0, n_samples], 0, buf) }.to raise_error(ArgumentError)
+    expect { mlp.send(:gather_rows, x, Numo::Int32[-1, 0], 0, buf) }.to raise_error(ArgumentError)
+    expect { mlp.send(:gather_rows, x, Numo::Int32[0, 1], 1, buf) }.to raise_error(ArgumentError)
+    expect { mlp.send(:gather_rows, x, Numo::Int32[0, 1], 0, Numo::DFloat.zeros(2, n_features + 1)) }.to raise_error(ArgumentError)
   end
 end
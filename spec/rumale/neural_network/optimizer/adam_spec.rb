@@ -14,4 +14,13 @@ RSpec.describe Rumale::NeuralNetwork::Optimizer::Adam do
     expect(optimizer.instance_variable_get(:@sec_moment)).to eq(copied.instance_variable_get(:@sec_moment))
     expect(optimizer.instance_variable_get(:@iter)).to eq(copied.instance_variable_get(:@iter))
   end
+
+  it 'updates the weight in place with the same result as the call method.', :aggregate_failures do
+    weight = Numo::DFloat[1, 2, 3]
+    gradient = Numo::DFloat[0.1, -0.2, 0.3]
+    expected = described_class.new(learning_rate: 0.1, decay1: 0.8, decay2: 0.8).call(weight, gradient)
+    updated = optimizer.update(weight, gradient)
+    expect(updated).to equal(weight)
+    expect((weight - expected).abs.max).to be < 1e-12
+  end
 end
@@ -32,4 +32,47 @@ RSpec.describe Rumale::Pipeline::FeatureUnion do
     expect(zz.shape[0]).to eq(n_samples)
     expect(zz.shape[1]).to eq(sum_n_comps)
   end
+
+  it 'transforms the same data in parallel as sequential execution.', aggregate_failures: true do
+    par_fu = described_class.new(transformers: Marshal.load(Marshal.dump({ rbf: rbf, pca: pca, nmf: nmf })), n_jobs: -1)
+    expect(par_fu.fit_transform(x)).to eq(z)
+    expect(par_fu.transform(x)).to eq(z)
+  end
+
+  it 'writes each transformed data into its columns.', aggregate_failures: true do
+    expect(z[true, 0...n_rbf_comps]).to eq(fu.transformers[:rbf].transform(x))
+    expect(z[true, n_rbf_comps...(n_rbf_comps + n_pca_comps)]).to eq(fu.transformers[:pca].transform(x))
+    expect(z[true, (n_rbf_comps + n_pca_comps)..-1]).to eq(fu.transformers[:nmf].transform(x))
+  end
+
+  it 'concatenates the transformed data of no samples.', aggregate_failures: true do
+    doubler = Class.new do
+      def fit(_x, _y = nil)
+        self
+      end
+
+      def transform(x)
+        x * 2
+      end
+    end
+    empty_z = described_class.new(transformers: { a: doubler.new, b: doubler.new }).fit(x).transform(Numo::DFloat.zeros(0, n_features))
+    expect(empty_z.shape).to eq([0, 2 * n_features])
+  end
+
+  it 'keeps the data type of the transformed data.', aggregate_failures: true do
+    rounder = Class.new do
+      def fit(_x, _y = nil)
+        self
+      end
+
+      def transform(x)
+        Numo::Int32.cast(x.round)
+      end
+    end
+    int_z = described_class.new(transformers: { a: rounder.new, b: rounder.new }).fit(x).transform(x)
+    expect(int_z.class).to eq(Numo::Int32)
+    expect(int_z).to eq(Numo::Int32.cast(x.round).tile(1, 2))
+    mixed_z = described_class.new(transformers: { a: rounder.new, pca: pca }).fit(x).transform(x)
+    expect(mixed_z.class).to eq(Numo::DFloat)
+  end
 end
@@ -1,6 +1,7 @@
 # frozen_string_literal: true
 
 require 'spec_helper'
+require 'tmpdir'
 
 RSpec.describe Rumale::Pipeline::Pipeline do
   let(:xor) { xor_dataset }
@@ -93,6 +94,40 @@ RSpec.describe Rumale::Pipeline::Pipeline do
     end
   end
 
+  context 'when caching the fitted transformers' do
+    let(:x) { xor[0] }
+    let(:y) { xor[1] }
+
+    it 'reuses the fitted transformers for the pipelines with the same transformers.', :aggregate_failures do
+      Dir.mktmpdir do |dir|
+        pipe = described_class.new(steps: { rbf: rbf, pca: pca, skip: nil, svc: svc }, memory: dir).fit(x, y)
+        expect(Dir.glob(File.join(dir, '*.dat')).size).to eq(2)
+        other_svc = Rumale::LinearModel::SVC.new(reg_param: 0.01, random_seed: 1)
+        other_pipe = described_class.new(steps: { rbf: rbf, pca: pca, skip: nil, svc: other_svc }, memory: dir).fit(x, y)
+        expect(Dir.glob(File.join(dir, '*.dat')).size).to eq(2)
+        expect(other_pipe.steps[:pca].components).to eq(pipe.steps[:pca].components)
+        expect(other_pipe.transform(x)).to eq(pipe.transform(x))
+        expected = described_class.new(steps: { rbf: rbf, pca: pca, skip: nil, svc: other_svc }).fit(x, y)
+        expect(other_pipe.predict(x)).to eq(expected.predict(x))
+        described_class.new(steps: { rbf: rbf, pca: pca, skip: nil, svc: svc }, memory: dir).fit(x[0...-1, true], y[0...-1])
+        expect(Dir.glob(File.join(dir, '*.dat')).size).to eq(4)
+      end
+    end
+
+    it 'keeps the given transformer objects and restores their states from the cache.', :aggregate_failures do
+      Dir.mktmpdir do |dir|
+        pipe = described_class.new(steps: { pca: pca, svc: svc }, memory: dir).fit(x, y)
+        other_pca = Rumale::Decomposition::PCA.new(n_components: n_pca_comps, tol: 1.0e-8, random_seed: 1)
+        other_svc = Rumale::LinearModel::SVC.new(reg_param: 0.01, random_seed: 1)
+        other_pipe = described_class.new(steps: { pca: other_pca, svc: other_svc }, memory: dir).fit(x, y)
+        expect(other_pipe.steps[:pca]).to equal(other_pca)
+        expect(other_pca.components).to eq(pipe.steps[:pca].components)
+        expect(other_pipe.clear_cache).to equal(other_pipe)
+        expect(Dir.glob(File.join(dir, '*.dat'))).to be_empty
+      end
+    end
+  end
+
   it 'raises TypeError when given steps including a non-transformer and non-estimator.', :aggregate_failures do
     expect { described_class.new(steps: { rbf: rbf, bad: 'skip', svc: svc }) }.to raise_error(TypeError)
     expect { described_class.new(steps: { rbf: rbf, bad: 'skip' }) }.to raise_error(TypeError)
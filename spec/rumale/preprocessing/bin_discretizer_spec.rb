@@ -20,6 +20,35 @@ RSpec.describe Rumale::Preprocessing::BinDiscretizer do
     expect(transformed[true, 0].to_a.uniq.size).to be <= n_bins
   end
 
+  it 'assigns each value to the largest bin whose step is less than or equal to the value.', :aggregate_failures do
+    x = Numo::DFloat[[0, 10], [1, 12], [2, 14], [3, 16], [4, 18]]
+    expect(described_class.new(n_bins: 4).fit_transform(x)).to eq(Numo::DFloat[[0, 0], [1, 1], [2, 2], [3, 3], [3, 3]])
+    expect(described_class.new(n_bins: 4).fit(x).transform([[-1, 11], [2.5, 100]])).to eq(Numo::DFloat[[0, 0], [2, 3]])
+  end
+
+  [Numo::UInt8, Numo::UInt16, Numo::Int32].each do |klass|
+    context "when dtype is #{klass}" do
+      let(:discretizer) { described_class.new(n_bins: n_bins, dtype: klass) }
+
+      it 'discretizes to the same bins as floating point output.', :aggregate_failures do
+        transformed = discretizer.fit_transform(samples)
+        expect(transformed).to be_a(klass)
+        expect(transformed).to eq(klass.cast(described_class.new(n_bins: n_bins).fit_transform(samples)))
+      end
+    end
+  end
+
+  it 'raises ArgumentError when the number of bins exceeds the range of dtype.', :aggregate_failures do
+    expect { described_class.new(n_bins: 257, dtype: Numo::UInt8) }.to raise_error(ArgumentError)
+    expect { described_class.new(n_bins: 256, dtype: Numo::UInt8) }.not_to raise_error
+    expect { described_class.new(n_bins: 8, dtype: Numo::SFloat) }.to raise_error(ArgumentError)
+  end
+
+  it 'raises ArgumentError when given the samples with a different number of features from the fitted samples.' do
+    discretizer.fit(samples)
+    expect { discretizer.transform(Numo::DFloat.new(n_samples, n_features + 1).rand) }.to raise_error(ArgumentError)
+  end
+
   it 'dumps and restores itself using Marshal module.' do
     discretizer.fit(samples)
     copied = Marshal.load(Marshal.dump(discretizer))
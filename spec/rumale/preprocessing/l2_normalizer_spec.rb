@@ -31,4 +31,18 @@ RSpec.describe Rumale::Preprocessing::L2Normalizer do
       expect(normalizer.norm_vec[0]).to eq(1)
     end
   end
+
+  context 'when copy parameter is false' do
+    let(:x) { Numo::DFloat.new(n_samples, n_features).rand - 0.5 }
+    let(:normalizer) { described_class.new(copy: false) }
+
+    it 'normalizes samples in place.' do
+      expected = described_class.new.fit_transform(x)
+      z = x.dup
+      expect(normalizer.fit_transform(z)).to equal(z)
+      expect((z - expected).abs.max).to be < 1.0e-8
+      expect(normalizer.norm_vec.shape[0]).to eq(n_samples)
+      expect { normalizer.transform!(Numo::SFloat.cast(x)) }.to raise_error(TypeError)
+    end
+  end
 end
@@ -21,6 +21,35 @@ RSpec.describe Rumale::Preprocessing::MaxAbsScaler do
     expect(normalizer.max_abs_vec[1]).to eq(0.9)
   end
 
+  it 'calculates the same maximum absolute values from chunks of samples with partial_fit.' do
+    normalizer = described_class.new
+    normalizer.partial_fit(samples[0...1, true]).partial_fit(samples[1..-1, true])
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect(normalizer.max_abs_vec).to eq(Numo::DFloat[0.8, 0.9])
+  end
+
+  it 'merges the maximum absolute values of normalizers fitted on shards of samples.' do
+    normalizer = described_class.new.fit(samples[0...2, true])
+    normalizer.merge(described_class.new.fit(samples[2..-1, true]))
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect(normalizer.max_abs_vec).to eq(Numo::DFloat[0.8, 0.9])
+    expect { normalizer.merge(Rumale::Preprocessing::StandardScaler.new) }.to raise_error(ArgumentError)
+  end
+
+  it 'scales samples in place with transform! and copy: false option.' do
+    normalizer = described_class.new.fit(samples)
+    expected = normalizer.transform(samples)
+    x = samples.dup
+    expect(normalizer.transform!(x)).to equal(x)
+    expect(x).to eq(expected)
+    x = samples.dup
+    normalizer = described_class.new(copy: false).fit(samples)
+    expect(normalizer.transform(x)).to equal(x)
+    expect(x).to eq(expected)
+    expect { normalizer.transform!(Numo::SFloat.cast(samples)) }.to raise_error(TypeError)
+    expect { normalizer.transform!(Numo::DFloat.new(2, n_features + 1).rand) }.to raise_error(ArgumentError)
+  end
+
   it 'dumps and restores itself using Marshal module.' do
     transformer = described_class.new
     transformer.fit(samples)
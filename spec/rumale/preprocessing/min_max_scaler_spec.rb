@@ -39,6 +39,37 @@ RSpec.describe Rumale::Preprocessing::MinMaxScaler do
     expect(normalized.max).to eq(1)
   end
 
+  it 'calculates the same minimum and maximum values from chunks of samples with partial_fit.' do
+    normalizer = described_class.new
+    normalizer.partial_fit(samples[0...3, true]).partial_fit(samples[3..-1, true])
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect(normalizer.min_vec).to eq(samples.min(0))
+    expect(normalizer.max_vec).to eq(samples.max(0))
+  end
+
+  it 'merges the minimum and maximum values of normalizers fitted on shards of samples.' do
+    normalizer = described_class.new.fit(samples[0...5, true])
+    normalizer.merge(described_class.new.fit(samples[5..-1, true]))
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect(normalizer.min_vec).to eq(samples.min(0))
+    expect(normalizer.max_vec).to eq(samples.max(0))
+    expect { normalizer.partial_fit(Numo::DFloat.new(2, n_features + 1).rand) }.to raise_error(ArgumentError)
+  end
+
+  it 'scales samples in place with transform! and copy: false option.' do
+    normalizer = described_class.new.fit(samples)
+    expected = normalizer.transform(samples)
+    x = samples.dup
+    expect(normalizer.transform!(x)).to equal(x)
+    expect(x).to eq(expected)
+    x = samples.dup
+    normalizer = described_class.new(copy: false).fit(samples)
+    expect(normalizer.transform(x)).to equal(x)
+    expect(x).to eq(expected)
+    expect { normalizer.transform!(Numo::SFloat.cast(samples)) }.to raise_error(TypeError)
+    expect { normalizer.transform!(Numo::DFloat.new(2, n_features + 1).rand) }.to raise_error(ArgumentError)
+  end
+
   it 'dumps and restores itself using Marshal module.' do
     transformer = described_class.new
     transformer.fit(samples)
@@ -21,6 +21,46 @@ RSpec.describe Rumale::Preprocessing::OneHotEncoder do
     expect(encoder.transform(y)).to eq(Numo::DFloat[[1, 0, 0, 1, 0, 0, 1, 0, 0]])
   end
 
+  it 'ignores the values that do not occur in the training set' do
+    x = Numo::Int32[[0, 0, 10], [1, 1, 0], [0, 2, 1], [1, 0, 2]]
+    y = Numo::Int32[[2, 1, 3], [0, 5, 15]]
+    encoder.fit(x)
+    expect(encoder.transform(y)).to eq(Numo::DFloat[[0, 0, 0, 1, 0, 0, 0, 0, 0], [1, 0, 0, 0, 0, 0, 0, 0, 0]])
+  end
+
+  context 'when dtype is Numo::Int32' do
+    let(:encoder) { described_class.new(dtype: Numo::Int32) }
+
+    it 'encodes multi-label vector into one-hot-vectors of integer type', :aggregate_failures do
+      expect(encoder.fit_transform(labels)).to be_a(Numo::Int32)
+      expect(encoder.fit_transform(labels)).to eq(Numo::Int32.cast(codes))
+    end
+  end
+
+  context 'when sparse output is enabled' do
+    let(:encoder) { described_class.new(sparse: true) }
+    let(:x) { Numo::Int32[[0, 0, 10], [1, 1, 0], [0, 2, 1], [1, 0, 2]] }
+    let(:dense_codes) { described_class.new.fit_transform(x) }
+
+    it 'encodes samples into one-hot-vectors in CSR format', :aggregate_failures do
+      z = encoder.fit_transform(x)
+      expect(z).to be_a(Rumale::CSRMatrix)
+      expect(z.shape).to eq([4, 9])
+      expect(z.nnz).to eq(12)
+      expect(z.indptr).to eq(Numo::Int64[0, 3, 6, 9, 12])
+      expect(z.to_dense).to eq(dense_codes)
+    end
+  end
+
+  it 'raises ArgumentError when given the samples with a different number of features from the fitted samples' do
+    encoder.fit(Numo::Int32[[0, 0, 10], [1, 1, 0]])
+    expect { encoder.transform(Numo::Int32[[0, 1, 1, 0]]) }.to raise_error(ArgumentError)
+  end
+
+  it 'raises ArgumentError when given unsupported dtype' do
+    expect { described_class.new(dtype: Numo::SFloat) }.to raise_error(ArgumentError)
+  end
+
   it 'dumps and restores itself using Marshal module' do
     encoder.fit(labels)
     copied = Marshal.load(Marshal.dump(encoder))
@@ -4,7 +4,8 @@ require 'spec_helper'
 
 RSpec.describe Rumale::Preprocessing::PolynomialFeatures do
   let(:x) { Numo::DFloat[[0, 1], [2, 3], [4, 5]] }
-  let(:transformer) { described_class.new(degree: degree) }
+  let(:interaction_only) { false }
+  let(:transformer) { described_class.new(degree: degree, interaction_only: interaction_only) }
   let(:z) { transformer.fit_transform(x) }
 
   context 'when degree is 0' do
@@ -60,4 +61,68 @@ RSpec.describe Rumale::Preprocessing::PolynomialFeatures do
       expect(copied.n_output_features).to eq(transformer.n_output_features)
     end
   end
+
+  context 'when generating only interaction features' do
+    let(:x) { Numo::DFloat[[1, 2, 3], [4, 5, 6]] }
+    let(:degree) { 3 }
+    let(:interaction_only) { true }
+
+    it 'obtains polynomial expanded features consisting of distinct features', :aggregate_failures do
+      expect(z).to eq(Numo::DFloat[
+        [1, 1, 2, 3, 2, 3, 6, 6],
+        [1, 4, 5, 6, 20, 24, 30, 120]
+      ])
+      expect(transformer.n_output_features).to eq(8)
+    end
+  end
+
+  context 'when given samples with a different number of features from the fitted samples' do
+    let(:degree) { 2 }
+    let(:wide_x) { Numo::DFloat[[1, 2, 3], [4, 5, 6]] }
+
+    it 'raises ArgumentError', :aggregate_failures do
+      transformer.fit(x)
+      expect { transformer.transform(wide_x) }.to raise_error(ArgumentError)
+      expect { transformer.transform(Rumale::CSRMatrix.from_dense(wide_x)) }.to raise_error(ArgumentError)
+    end
+  end
+
+  context 'when given sparse matrix in CSR format' do
+    let(:x) { Numo::DFloat[[0, 1, 0, 2], [0, 0, 0, 0], [3, 0, 4, 5]] }
+    let(:x_sparse) { Rumale::CSRMatrix.from_dense(x) }
+    let(:z_sparse) { transformer.fit_transform(x_sparse) }
+
+    [[2, false], [3, false], [3, true]].each do |deg, inter|
+      context "with degree: #{deg}, interaction_only: #{inter}" do
+        let(:degree) { deg }
+        let(:interaction_only) { inter }
+
+        it 'obtains the same polynomial features as dense one and stores only the monomials of stored elements', :aggregate_failures do
+          n_nonzeros = x_sparse.indptr[1..-1] - x_sparse.indptr[0...-1]
+          expected_nnz = n_nonzeros.to_a.sum do |k|
+            ids = Array.new(k) { |i| i }
+            1 + (1..deg).sum { |t| (inter ? ids.combination(t) : ids.repeated_combination(t)).count }
+          end
+          expect(z_sparse).to be_a(Rumale::CSRMatrix)
+          expect(z_sparse.shape).to eq([3, transformer.n_output_features])
+          expect(z_sparse.nnz).to eq(expected_nnz)
+          expect(z_sparse.to_dense).to eq(z)
+        end
+      end
+    end
+
+    context 'with the column indices that are not sorted in each row' do
+      let(:degree) { 2 }
+
+      it 'raises ArgumentError only when the column indices in a row are not sorted or duplicated.', :aggregate_failures do
+        transformer.fit(x_sparse)
+        unsorted = Rumale::CSRMatrix.new(Numo::DFloat[1, 2, 3, 4], Numo::Int32[1, 3, 2, 0], Numo::Int64[0, 2, 2, 4], [3, 4])
+        duplicated = Rumale::CSRMatrix.new(Numo::DFloat[1, 2, 3, 4], Numo::Int32[1, 3, 0, 0], Numo::Int64[0, 2, 2, 4], [3, 4])
+        expect { transformer.transform(unsorted) }.to raise_error(ArgumentError)
+        expect { transformer.transform(duplicated) }.to raise_error(ArgumentError)
+        rows_restarting = Rumale::CSRMatrix.new(Numo::DFloat[1, 2, 3, 4], Numo::Int32[1, 3, 0, 2], Numo::Int64[0, 2, 2, 4], [3, 4])
+        expect(transformer.transform(rows_restarting).to_dense).to eq(transformer.transform(rows_restarting.to_dense))
+      end
+    end
+  end
 end
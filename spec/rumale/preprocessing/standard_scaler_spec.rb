@@ -22,6 +22,43 @@ RSpec.describe Rumale::Preprocessing::StandardScaler do
     expect(normalizer.std_vec.shape[1]).to be_nil
   end
 
+  it 'calculates the same statistics from chunks of samples with partial_fit.' do
+    normalizer = described_class.new
+    normalizer.partial_fit(samples[0...3, true]).partial_fit(samples[3...7, true]).partial_fit(samples[7..-1, true])
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect((normalizer.mean_vec - samples.mean(0)).abs.max).to be < 1.0e-8
+    expect((normalizer.std_vec - samples.stddev(0)).abs.max).to be < 1.0e-8
+  end
+
+  it 'merges the statistics of normalizers fitted on shards of samples.' do
+    normalizer = described_class.new.fit(samples[0...4, true])
+    normalizer.merge(described_class.new.fit(samples[4..-1, true]))
+    expect(normalizer.n_samples_seen).to eq(n_samples)
+    expect((normalizer.mean_vec - samples.mean(0)).abs.max).to be < 1.0e-8
+    expect((normalizer.std_vec - samples.stddev(0)).abs.max).to be < 1.0e-8
+    expect(described_class.new.merge(normalizer).mean_vec).to eq(normalizer.mean_vec)
+  end
+
+  it 'raises ArgumentError when given samples with a different number of features.' do
+    normalizer = described_class.new.fit(samples)
+    expect { normalizer.partial_fit(Numo::DFloat.new(2, n_features + 1).rand) }.to raise_error(ArgumentError)
+    expect { normalizer.merge(Rumale::Preprocessing::MaxAbsScaler.new) }.to raise_error(ArgumentError)
+  end
+
+  it 'scales samples in place with transform! and copy: false option.' do
+    normalizer = described_class.new.fit(samples)
+    expected = normalizer.transform(samples)
+    x = samples.dup
+    expect(normalizer.transform!(x)).to equal(x)
+    expect(x).to eq(expected)
+    x = samples.dup
+    normalizer = described_class.new(copy: false).fit(samples)
+    expect(normalizer.transform(x)).to equal(x)
+    expect(x).to eq(expected)
+    expect { normalizer.transform!(Numo::SFloat.cast(samples)) }.to raise_error(TypeError)
+    expect { normalizer.transform!(Numo::DFloat.new(2, n_features + 1).rand) }.to raise_error(ArgumentError)
+  end
+
   it 'dumps and restores itself using Marshal module.' do
     transformer = described_class.new
     transformer.fit(samples)
@@ -0,0 +1,71 @@
+# frozen_string_literal: true
+
+require 'spec_helper'
+
+RSpec.describe Rumale::Utils do
+  describe '#rand_uniform' do
+    it 'generates random numbers over [0, 1) with the given shape', :aggregate_failures do
+      x = described_class.rand_uniform([1000, 50], Random.new(1))
+      expect(x.class).to eq(Numo::DFloat)
+      expect(x.shape).to eq([1000, 50])
+      expect(x.min).to be >= 0
+      expect(x.max).to be < 1
+      expect((x.mean - 0.5).abs).to be < 0.01
+      expect(described_class.rand_uniform(5, Random.new(1)).shape).to eq([5])
+    end
+
+    it 'generates the same random numbers with the same seed', :aggregate_failures do
+      expect(described_class.rand_uniform([100, 3], Random.new(42))).to eq(described_class.rand_uniform([100, 3], Random.new(42)))
+      expect(described_class.rand_uniform([100, 3], Random.new(42))).not_to eq(described_class.rand_uniform([100, 3], Random.new(43)))
+    end
+  end
+
+  describe '#rand_normal' do
+    it 'generates random numbers from the normal distribution with the given mean and deviation', :aggregate_failures do
+      x = described_class.rand_normal([50_000, 2], Random.new(1), 2.0, 3.0)
+      expect(x.shape).to eq([50_000, 2])
+      expect((x.mean - 2.0).abs).to be < 0.05
+      expect((x.stddev - 3.0).abs).to be < 0.05
+    end
+
+    it 'generates the same random numbers spanning multiple blocks with the same seed' do
+      rng = Random.new(7)
+      x = described_class.rand_normal(100_001, rng.dup)
+      expect(described_class.rand_normal([100_001], rng.dup)).to eq(x)
+    end
+  end
+
+  describe '#fill_uniform and #fill_normal' do
+    # the buffer spans more than 16 blocks of 4096 elements, so that it is filled with multiple threads.
+    let(:seed) { described_class.rand_seed(Random.new(3)) }
+    let(:single) { Numo::DFloat.new(100_001) }
+    let(:multi) { Numo::DFloat.new(100_001) }
+
+    it 'generates the same random numbers regardless of the number of threads', :aggregate_failures do
+      described_class.send(:fill_uniform, single, seed, 1)
+      described_class.send(:fill_uniform, multi, seed, 4)
+      expect(multi).to eq(single)
+      described_class.send(:fill_normal, single, seed, 0.0, 1.0, 1)
+      described_class.send(:fill_normal, multi, seed, 0.0, 1.0, 4)
+      expect(multi).to eq(single)
+      expect(described_class.rand_uniform(100_001, Random.new(3), n_jobs: nil)).to eq(described_class.rand_uniform(100_001, Random.new(3)))
+    end
+  end
+
+  describe '#n_threads' do
+    it 'returns the number of threads for the given number of jobs', :aggregate_failures do
+      expect(described_class.n_threads(nil)).to eq(1)
+      expect(described_class.n_threads(3)).to eq(3)
+      expect(described_class.n_threads(-1)).to eq(Etc.nprocessors)
+    end
+  end
+
+  describe '#n_processes' do
+    it 'returns the number of processes for the given number of jobs', :aggregate_failures do
+      expect(described_class.enable_parallel?(nil)).to be_falsey
+      expect(described_class.n_processes(nil)).to eq(1)
+      expect(described_class.n_processes(2)).to eq(2)
+      expect(described_class.n_processes(-1)).to eq(Parallel.processor_count)
+    end
+  end
+end
@@ -23,6 +23,14 @@ RSpec.describe Rumale::Validation do
     expect { described_class.check_label_array(Numo::Int32[[1, 2, 3], [4, 5, 6]]) }.to raise_error(ArgumentError)
   end
 
+  it 'detects array that cannot be modified in place.' do
+    x = Numo::DFloat[[1, 2, 3], [4, 5, 6]]
+    expect(described_class.check_inplace_sample_array(x)).to be_nil
+    expect { described_class.check_inplace_sample_array(Numo::Int32[[1, 2, 3], [4, 5, 6]]) }.to raise_error(TypeError)
+    expect { described_class.check_inplace_sample_array(Numo::DFloat[1, 2, 3]) }.to raise_error(ArgumentError)
+    expect { described_class.check_inplace_sample_array(x.transpose) }.to raise_error(ArgumentError)
+  end
+
   it 'detects invalid number of samples.' do
     x = Numo::DFloat[[1, 2], [3, 4], [5, 6]]
     y = Numo::Int32[1, 2]